@@ -0,0 +1,68 @@
+# Print static RAM use per component after a firmware build
+#
+# Run by the bassmint POST_BUILD step:
+#   cmake -DNM=<nm> -DREPORT_LIB=<bassmint_ram_report archive> -DELF=<bassmint.elf>
+#         -P RamReport.cmake
+#
+# REPORT_LIB holds one bassmint_ram_<component> array per component, each
+# sizeof() the real type (src/app/RamReport.cpp). ELF gives the total of
+# every linked .bss/.data object.
+
+function(read_symbols file out_var)
+    execute_process(
+        COMMAND ${NM} -p -S --defined-only ${file}
+        OUTPUT_VARIABLE output
+        RESULT_VARIABLE result
+        ERROR_QUIET
+    )
+    if(NOT result EQUAL 0)
+        message(WARNING "RAM report: ${NM} failed on ${file}")
+    endif()
+    string(REPLACE "\n" ";" lines "${output}")
+    set(${out_var} "${lines}" PARENT_SCOPE)
+endfunction()
+
+function(print_row name bytes)
+    set(spaces " ")
+    string(LENGTH "${name}${spaces}" length)
+    while(length LESS 28)
+        string(APPEND spaces " ")
+        math(EXPR length "${length} + 1")
+    endwhile()
+    math(EXPR kib "(${bytes} * 10 + 512) / 1024")
+    math(EXPR kib_whole "${kib} / 10")
+    math(EXPR kib_tenth "${kib} % 10")
+    message("  ${name}${spaces}${bytes} B  (${kib_whole}.${kib_tenth} KB)")
+endfunction()
+
+message("RAM by component:")
+
+set(shared_scratch FALSE)
+read_symbols("${REPORT_LIB}" component_lines)
+foreach(line IN LISTS component_lines)
+    if(line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [bBdD] bassmint_ram_(.+)$")
+        math(EXPR bytes "0x${CMAKE_MATCH_1}")
+        print_row("${CMAKE_MATCH_2}" ${bytes})
+        if(CMAKE_MATCH_2 STREQUAL "ScratchArena")
+            set(shared_scratch TRUE)
+        endif()
+    endif()
+endforeach()
+
+# The price of sharing, so the saving above is not read as free
+if(shared_scratch)
+    message("  (ScratchArena is one region for all strings: a string's float")
+    message("   window and YIN d(tau) survive to its next estimate only while")
+    message("   no other string is active. With two or more ringing, the window")
+    message("   is converted in full and Incremental YIN recomputes d(tau) every")
+    message("   hop; the default Fft method and lag tracking lose nothing.)")
+endif()
+
+read_symbols("${ELF}" elf_lines)
+set(total 0)
+foreach(line IN LISTS elf_lines)
+    if(line MATCHES "^[0-9a-fA-F]+ ([0-9a-fA-F]+) [bBdD] ")
+        math(EXPR total "${total} + 0x${CMAKE_MATCH_1}")
+    endif()
+endforeach()
+print_row("linked .bss + .data" ${total})
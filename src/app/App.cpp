@@ -1,24 +1,73 @@
 #include "app/App.h"
 #include "hal/BoardConfig.h"
+#include <algorithm>
 #include <cstdio>
 
+#ifdef BASSMINT_DUAL_CORE
+#include "pico/multicore.h"
+#endif
+
 namespace BassMINT {
 
+// Pitch detection algorithm per string (E, A, D, G). MPM runs on shorter
+// windows; compare both with the BASSMINT_BENCHMARK build before switching.
+static constexpr PitchDetectorType STRING_PITCH_DETECTORS[NUM_STRINGS] = {
+    PitchDetectorType::Yin,
+    PitchDetectorType::Yin,
+    PitchDetectorType::Yin,
+    PitchDetectorType::Yin
+};
+
+// ADC capture: Dma delivers oversampled interleaved blocks (one IRQ per
+// block); Timer falls back to one timer IRQ per frame (every
+// ADC_TIMER_INTERVAL_US), reading all four strings back to back
+static constexpr AdcCaptureMode ADC_CAPTURE_MODE = AdcCaptureMode::Dma;
+
+// Omit repeated status bytes on the DIN link (Note Off goes out as Note On
+// velocity 0); turn off for receivers that mishandle running status
+static constexpr bool MIDI_RUNNING_STATUS = true;
+
+// Fret SysEx as version 2 bundles (all waiting strings in one frame). Off:
+// version 1, which every existing plugin understands; turn on only for
+// receivers that decode version 2
+static constexpr bool MIDI_SYSEX_BUNDLES = false;
+
+// SingleChannel: all strings on MIDI_CHANNEL, string + fret via SysEx.
+// PerStringChannel: MPE lower zone, string n on channel 2 + n with
+// continuous pitch bend; the channel identifies the string
+static constexpr MidiOutputMode MIDI_OUTPUT_MODE = MidiOutputMode::SingleChannel;
+
+// Fret SysEx alongside the notes (redundant with PerStringChannel)
+static constexpr bool MIDI_FRET_SYSEX = true;
+
+#ifdef BASSMINT_DUAL_CORE
+// Global instance pointer for the core1 entry point
+static App* g_appInstance = nullptr;
+#endif
+
 App::App()
-    : stringProcessors_{
-        StringProcessor(StringId::E),
-        StringProcessor(StringId::A),
-        StringProcessor(StringId::D),
-        StringProcessor(StringId::G)
+    : adcDriver_(*this)
+    , midiScheduler_(midiOut_)
+#ifdef BASSMINT_USB_MIDI
+    , usbMidiSink_(usbMidiOut_)
+#endif
+    , stringProcessors_{
+        StringProcessor(StringId::E, SAMPLE_RATE_HZ, PITCH_HOP_SIZE, STRING_PITCH_DETECTORS[0]),
+        StringProcessor(StringId::A, SAMPLE_RATE_HZ, PITCH_HOP_SIZE, STRING_PITCH_DETECTORS[1]),
+        StringProcessor(StringId::D, SAMPLE_RATE_HZ, PITCH_HOP_SIZE, STRING_PITCH_DETECTORS[2]),
+        StringProcessor(StringId::G, SAMPLE_RATE_HZ, PITCH_HOP_SIZE, STRING_PITCH_DETECTORS[3])
     }
     , stringManagers_{
-        StringManager(StringId::E, midiOut_),
-        StringManager(StringId::A, midiOut_),
-        StringManager(StringId::D, midiOut_),
-        StringManager(StringId::G, midiOut_)
+        StringManager(StringId::E, noteBus_),
+        StringManager(StringId::A, noteBus_),
+        StringManager(StringId::D, noteBus_),
+        StringManager(StringId::G, noteBus_)
     }
     , loopCounter_(0)
     , lastStatsTime_(0)
+    , reportCount_(0)
+    , reportLatencySumUs_(0)
+    , reportLatencyMaxUs_(0)
 {
 }
 
@@ -32,22 +81,34 @@ bool App::init() {
 
     // Initialize MIDI output
     midiOut_.init();
+    midiOut_.setRunningStatus(MIDI_RUNNING_STATUS);
+    midiScheduler_.setSysExBundles(MIDI_SYSEX_BUNDLES);
+    midiScheduler_.setFretSysEx(MIDI_FRET_SYSEX);
+    noteBus_.subscribe(midiScheduler_);
+#ifdef BASSMINT_USB_MIDI
+    usbMidiSink_.setSysExBundles(MIDI_SYSEX_BUNDLES);
+    usbMidiSink_.setFretSysEx(MIDI_FRET_SYSEX);
+    noteBus_.subscribe(usbMidiSink_);
+#endif
+    for (auto& manager : stringManagers_) {
+        manager.setOutputMode(MIDI_OUTPUT_MODE);
+    }
+    if (MIDI_OUTPUT_MODE == MidiOutputMode::PerStringChannel) {
+        sendMpeConfiguration();
+    }
 
     // Initialize ADC
-    adcDriver_.init();
-
-    // Set ADC callback (captures 'this' for member function call)
-    adcDriver_.setSampleCallback(
-        [this](StringId stringId, uint16_t sample) {
-            this->onAdcSample(stringId, sample);
-        }
-    );
+    adcDriver_.init(ADC_CAPTURE_MODE);
 
     // Start ADC sampling
     adcDriver_.startSampling();
 
     lastStatsTime_ = Timer::getTimeMillis();
 
+#ifdef BASSMINT_DUAL_CORE
+    g_appInstance = this;
+#endif
+
     printf("BassMINT initialized successfully!\n");
     printf("Sample rate: %lu Hz\n", SAMPLE_RATE_HZ);
     printf("Frame size: %lu samples\n", PITCH_FRAME_SIZE);
@@ -57,6 +118,11 @@ bool App::init() {
 }
 
 void App::run() {
+#ifdef BASSMINT_DUAL_CORE
+    // DSP moves to core1; this core keeps ADC IRQs and MIDI
+    multicore_launch_core1(core1Entry);
+#endif
+
     // Main loop - runs forever
     while (true) {
         tick();
@@ -64,14 +130,36 @@ void App::run() {
 }
 
 void App::tick() {
+#ifdef BASSMINT_USB_MIDI
+    // USB device stack (MIDI and the stdio serial port); a host that has
+    // just opened the MIDI interface missed the setup sent so far
+    if (usbMidiOut_.task()) {
+        usbMidiSink_.onConnected();
+    }
+#endif
+
+#ifdef BASSMINT_DUAL_CORE
+    // MIDI event generation from whatever core1 has reported
+    StringReport report;
+    while (reportQueue_.pop(report)) {
+        applyReport(report);
+    }
+#else
     // Process each string
     for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
         // DSP processing (envelope, pitch detection)
         stringProcessors_[i].process();
 
         // MIDI event generation
-        stringManagers_[i].update(stringProcessors_[i]);
+        applyReport(stringProcessors_[i].getReport(Timer::getTimeMicros()));
     }
+#endif
+
+    // Hand this pass' note events to the outputs
+    noteBus_.dispatch();
+
+    // Waiting SysEx go out once the notes have left
+    midiScheduler_.service();
 
     // Increment loop counter
     loopCounter_++;
@@ -83,6 +171,9 @@ void App::tick() {
         printStats();
         lastStatsTime_ = now;
         loopCounter_ = 0;
+        reportCount_ = 0;
+        reportLatencySumUs_ = 0;
+        reportLatencyMaxUs_ = 0;
     }
 
     // Optional: yield to other tasks or sleep
@@ -90,13 +181,20 @@ void App::tick() {
 }
 
 void App::shutdown() {
+#ifdef BASSMINT_DUAL_CORE
+    // Stop DSP first so no more reports arrive
+    multicore_reset_core1();
+#endif
+
     // Stop ADC sampling
     adcDriver_.stopSampling();
 
-    // Turn off all active notes
+    // Turn off all active notes, and let them leave before going quiet
     for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
         stringManagers_[i].forceNoteOff();
     }
+    noteBus_.dispatch();
+    midiOut_.flush();
 
     // Turn off LEDs
     ledDriver_.allLedsOff();
@@ -104,6 +202,48 @@ void App::shutdown() {
     printf("BassMINT shutdown complete.\n");
 }
 
+void App::sendMpeConfiguration() {
+    // One member channel per string; receivers default to ±48 semitones.
+    // Through the bus, so every sink announces it (USB again on each mount)
+    noteBus_.publish(NoteEvent::mpeConfiguration(MPE_MASTER_CHANNEL, NUM_STRINGS));
+    noteBus_.dispatch();
+}
+
+void App::applyReport(const StringReport& report) {
+    uint8_t index = static_cast<uint8_t>(report.string);
+    if (index >= NUM_STRINGS) {
+        return;
+    }
+
+    stringManagers_[index].update(report);
+
+#ifdef BASSMINT_DUAL_CORE
+    latestReports_[index] = report;
+#endif
+
+    // Time from the DSP snapshot to the MIDI decision (and any bytes sent)
+    uint32_t latencyUs = Timer::getElapsedMicros(report.timestampUs);
+    reportCount_++;
+    reportLatencySumUs_ += latencyUs;
+    reportLatencyMaxUs_ = std::max(reportLatencyMaxUs_, latencyUs);
+}
+
+#ifdef BASSMINT_DUAL_CORE
+void App::core1Entry() {
+    if (g_appInstance) {
+        g_appInstance->runDsp();
+    }
+}
+
+void App::runDsp() {
+    // Core1 context: all string DSP, nothing else
+    while (true) {
+        reportQueue_.processStrings(stringProcessors_.data(), NUM_STRINGS,
+                                    Timer::getTimeMicros);
+    }
+}
+#endif
+
 void App::onAdcSample(StringId stringId, uint16_t sample) {
     // ISR context - must be fast!
     uint8_t index = static_cast<uint8_t>(stringId);
@@ -112,22 +252,83 @@ void App::onAdcSample(StringId stringId, uint16_t sample) {
     }
 }
 
+void App::onAdcBlock(StringId stringId, const uint16_t* samples, size_t count) {
+    // ISR context, once per string per DMA block: one bulk push
+    uint8_t index = static_cast<uint8_t>(stringId);
+    if (index < NUM_STRINGS) {
+        stringProcessors_[index].pushBlock(samples, count);
+    }
+}
+
 void App::printStats() {
     // Print debug statistics (optional, disable for production)
     #ifdef BASSMINT_DEBUG_STATS
     printf("--- Stats (loops/sec: %lu) ---\n", loopCounter_);
 
+    if (adcDriver_.getCaptureMode() == AdcCaptureMode::Dma) {
+        printf("ADC DMA: blocks=%lu, dropped=%lu\n",
+               static_cast<unsigned long>(adcDriver_.getCompletedBlocks()),
+               static_cast<unsigned long>(adcDriver_.getDroppedBlocks()));
+    }
+
+    printf("Report->MIDI: %lu reports, avg %lu us, max %lu us\n",
+           static_cast<unsigned long>(reportCount_),
+           static_cast<unsigned long>(reportCount_ ? reportLatencySumUs_ / reportCount_ : 0),
+           static_cast<unsigned long>(reportLatencyMaxUs_));
+
+    printf("MIDI TX: pending=%lu, max=%lu, dropped=%lu msgs (%lu bytes)\n",
+           static_cast<unsigned long>(midiOut_.getPendingBytes()),
+           static_cast<unsigned long>(midiOut_.getMaxPendingBytes()),
+           static_cast<unsigned long>(midiOut_.getDroppedMessages()),
+           static_cast<unsigned long>(midiOut_.getDroppedBytes()));
+
+#ifdef BASSMINT_USB_MIDI
+    printf("USB MIDI: %s, transfers=%lu, packets=%lu, dropped=%lu\n",
+           usbMidiOut_.isConnected() ? "connected" : "no host",
+           static_cast<unsigned long>(usbMidiOut_.getTransfers()),
+           static_cast<unsigned long>(usbMidiOut_.getSentPackets()),
+           static_cast<unsigned long>(usbMidiOut_.getDroppedPackets()));
+#endif
+
+    printf("Note events dropped: %lu\n",
+           static_cast<unsigned long>(noteBus_.getDroppedEvents()));
+
+    printf("MIDI SysEx: waiting=%lu, coalesced=%lu\n",
+           static_cast<unsigned long>(midiScheduler_.getPendingSysEx()),
+           static_cast<unsigned long>(midiScheduler_.getCoalescedSysEx()));
+
+    if (MIDI_OUTPUT_MODE == MidiOutputMode::PerStringChannel) {
+        printf("MIDI bends: sent=%lu, coalesced=%lu\n",
+               static_cast<unsigned long>(midiScheduler_.getSentBends()),
+               static_cast<unsigned long>(midiScheduler_.getCoalescedBends()));
+    }
+
+#ifdef BASSMINT_DUAL_CORE
+    printf("Report queue dropped: %lu\n",
+           static_cast<unsigned long>(reportQueue_.getDropped()));
+#endif
+
     for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
         const char* stringNames[] = {"E", "A", "D", "G"};
         const auto& proc = stringProcessors_[i];
         const auto& mgr = stringManagers_[i];
 
+#ifdef BASSMINT_DUAL_CORE
+        // Processor internals belong to core1: show the snapshot core0
+        // last took from the report queue
+        const StringReport& report = latestReports_[i];
+#else
+        StringReport report = proc.getReport();
+#endif
+
+        // Buffer level comes from the sample ring's atomic indices (the
+        // ADC IRQ producing into it runs on core0)
         printf("String %s: buf=%zu, env=%.3f, state=%d, pitch=%.1fHz (MIDI %u, fret %d) %s\n",
                stringNames[i],
                proc.getBufferLevel(),
-               proc.getEnvelope(),
-               static_cast<int>(proc.getState()),
-               proc.getLatestPitch().frequency,
+               report.envelope,
+               static_cast<int>(report.state),
+               report.pitch.frequencyHz,
                mgr.getCurrentMidiNote(),
                mgr.getCurrentFret(),
                mgr.isNoteOn() ? "[ON]" : "");
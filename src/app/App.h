@@ -1,12 +1,19 @@
 #pragma once
 
 #include "core/Types.h"
+#include "app/MidiScheduler.h"
+#include "app/NoteEventBus.h"
 #include "app/StringManager.h"
+#include "app/StringReportQueue.h"
 #include "dsp/StringProcessor.h"
 #include "hal/AdcDriver.h"
 #include "hal/MidiDinOut.h"
 #include "hal/LedDriver.h"
 #include "hal/Timer.h"
+#ifdef BASSMINT_USB_MIDI
+#include "app/UsbMidiSink.h"
+#include "hal/UsbMidiOut.h"
+#endif
 #include <array>
 #include <cstdint>
 
@@ -22,6 +29,11 @@ namespace BassMINT {
  * - Coordinate ADC sampling -> DSP processing -> MIDI output pipeline
  * - Main loop execution
  *
+ * With BASSMINT_DUAL_CORE the pipeline is split: core1 runs the four
+ * StringProcessors and posts a StringReport whenever one consumed
+ * samples; core0 keeps acquisition (ADC IRQs), StringManager decisions
+ * and MIDI output, fed from a StringReportQueue.
+ *
  * This is the "god object" that ties everything together.
  */
 class App {
@@ -53,11 +65,26 @@ public:
     void shutdown();
 
 private:
+    // AdcDriver calls onAdcSample()/onAdcBlock() directly from its ISRs
+    friend class AdcDriver<App>;
+
     // HAL drivers
-    AdcDriver adcDriver_;
+    AdcDriver<App> adcDriver_;
     MidiDinOut midiOut_;
     LedDriver ledDriver_;
 
+    // Note events before SysEx on the DIN link
+    MidiScheduler midiScheduler_;
+
+#ifdef BASSMINT_USB_MIDI
+    // Same note events over USB-MIDI, written once per tick
+    UsbMidiOut usbMidiOut_;
+    UsbMidiSink usbMidiSink_;
+#endif
+
+    // StringManagers -> output sinks (midiScheduler_, ...)
+    NoteBus noteBus_;
+
     // Per-string DSP processors
     std::array<StringProcessor, NUM_STRINGS> stringProcessors_;
 
@@ -68,12 +95,51 @@ private:
     uint32_t loopCounter_;
     uint32_t lastStatsTime_;
 
+    // DSP report -> MIDI decision latency (per stats period)
+    uint32_t reportCount_;
+    uint32_t reportLatencySumUs_;
+    uint32_t reportLatencyMaxUs_;
+
+#ifdef BASSMINT_DUAL_CORE
+    // Core1 (producer) -> core0 (consumer)
+    StringReportQueue reportQueue_;
+
+    // Last report applied per string (core0 only)
+    std::array<StringReport, NUM_STRINGS> latestReports_;
+
+    /**
+     * @brief Core1 entry point (static for C linkage)
+     */
+    static void core1Entry();
+
     /**
-     * @brief ADC sample callback (called from ISR)
+     * @brief DSP loop on core1 (never returns)
+     */
+    void runDsp();
+#endif
+
+    /**
+     * @brief Announce the MPE lower zone to every sink (PerStringChannel mode)
+     */
+    void sendMpeConfiguration();
+
+    /**
+     * @brief Hand a DSP report to its StringManager and record latency
+     */
+    void applyReport(const StringReport& report);
+
+    /**
+     * @brief ADC sample sink (called from timer ISR)
      * Pushes samples into appropriate string processor
      */
     void onAdcSample(StringId stringId, uint16_t sample);
 
+    /**
+     * @brief ADC block sink (called from DMA ISR, once per string)
+     * Pushes one string's decimated samples into its processor
+     */
+    void onAdcBlock(StringId stringId, const uint16_t* samples, size_t count);
+
     /**
      * @brief Print debug statistics (if USB serial enabled)
      */
@@ -0,0 +1,564 @@
+#include "app/Benchmark.h"
+#include "core/NoteMapping.h"
+#include "dsp/PitchDetectorYin.h"
+#include "dsp/PitchDetectorMpm.h"
+#include "dsp/PitchDetectorYinFixed.h"
+#include "dsp/PitchDetectorYinMultiRes.h"
+#include "dsp/RingBuffer.h"
+#include "dsp/SpscRingBuffer.h"
+#include "dsp/YinKernel.h"
+#include "hal/Timer.h"
+#include "hardware/clocks.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <functional>
+
+namespace BassMINT {
+
+// Corpus: every string at these frets
+static constexpr int CORPUS_FRETS[] = {0, 3, 5, 7, 12, 17, 24};
+static constexpr size_t NUM_CORPUS_FRETS = sizeof(CORPUS_FRETS) / sizeof(CORPUS_FRETS[0]);
+static constexpr size_t CORPUS_SIZE = NUM_STRINGS * NUM_CORPUS_FRETS;
+
+// Each corpus frame is estimated this many times to average out timer jitter
+static constexpr uint32_t REPEATS = 4;
+
+static constexpr float TWO_PI = 6.28318530718f;
+
+static std::array<float, PITCH_FRAME_SIZE> g_frame;
+static std::array<uint16_t, PITCH_FRAME_SIZE> g_rawFrame;
+static std::array<PitchEstimate, CORPUS_SIZE> g_reference;
+static std::array<PitchEstimate, CORPUS_SIZE> g_results;
+
+struct BenchmarkResult {
+    uint32_t totalUs = 0;
+    uint32_t worstUs = 0;
+    float maxCentsError = 0.0f; // vs. reference estimate
+    uint32_t validityMismatches = 0;
+};
+
+/**
+ * @brief Synthesize one frame of a decaying, harmonic-rich bass pluck
+ * @param frequency Fundamental in Hz
+ * @param startTime Time since the pluck of the first sample, in seconds
+ *                  (negative: silence until the pluck)
+ */
+static void synthesizePluckAt(float frequency, float startTime) {
+    for (size_t i = 0; i < PITCH_FRAME_SIZE; ++i) {
+        float t = startTime + static_cast<float>(i) / static_cast<float>(SAMPLE_RATE_HZ);
+        if (t < 0.0f) {
+            g_frame[i] = 0.0f;
+            g_rawFrame[i] = 2048;
+            continue;
+        }
+
+        float phase = TWO_PI * frequency * t;
+        float envelope = std::exp(-2.0f * t);
+
+        float value = 0.50f * std::sin(phase)
+                    + 0.25f * std::sin(2.0f * phase + 0.3f)
+                    + 0.12f * std::sin(3.0f * phase + 1.1f)
+                    + 0.06f * std::sin(4.0f * phase + 2.0f);
+
+        g_frame[i] = 0.8f * envelope * value;
+
+        // Same frame as 12-bit ADC codes for the integer detectors
+        g_rawFrame[i] = static_cast<uint16_t>(std::lround(2048.0f + g_frame[i] * 2047.0f));
+    }
+}
+
+/**
+ * @brief Synthesize the frame for a corpus index (varies the decay offset)
+ */
+static void synthesizePluck(float frequency, size_t index) {
+    synthesizePluckAt(frequency, 0.02f * static_cast<float>(index % 5));
+}
+
+static float corpusFrequency(size_t index) {
+    StringId string = static_cast<StringId>(index / NUM_CORPUS_FRETS);
+    int fret = CORPUS_FRETS[index % NUM_CORPUS_FRETS];
+    return NoteMapping::getOpenStringFrequency(string) * std::exp2(static_cast<float>(fret) / 12.0f);
+}
+
+/**
+ * @brief Accumulate one timed estimate against its reference
+ */
+static void accumulate(BenchmarkResult& result, uint32_t elapsedUs,
+                       const PitchEstimate& ref, const PitchEstimate& got) {
+    result.totalUs += elapsedUs;
+    result.worstUs = std::max(result.worstUs, elapsedUs);
+
+    if (ref.isValid() != got.isValid()) {
+        result.validityMismatches++;
+    } else if (ref.isValid()) {
+        float cents = std::fabs(1200.0f * std::log2(got.frequencyHz / ref.frequencyHz));
+        result.maxCentsError = std::max(result.maxCentsError, cents);
+    }
+}
+
+/**
+ * @brief Time an estimator over the whole corpus
+ * @param estimate Callable: PitchEstimate(const float* samples, size_t count)
+ */
+template<typename EstimateFn>
+static BenchmarkResult measure(EstimateFn&& estimate) {
+    BenchmarkResult result;
+
+    for (size_t index = 0; index < CORPUS_SIZE; ++index) {
+        synthesizePluck(corpusFrequency(index), index);
+
+        for (uint32_t r = 0; r < REPEATS; ++r) {
+            uint32_t start = Timer::getTimeMicros();
+            g_results[index] = estimate(g_frame.data(), PITCH_FRAME_SIZE);
+            accumulate(result, Timer::getElapsedMicros(start), g_reference[index], g_results[index]);
+        }
+    }
+
+    return result;
+}
+
+static void printResult(const char* name, const BenchmarkResult& result,
+                        uint32_t frames = CORPUS_SIZE * REPEATS) {
+    float avgUs = static_cast<float>(result.totalUs) / static_cast<float>(frames);
+    float cyclesPerUs = static_cast<float>(clock_get_hz(clk_sys)) / 1.0e6f;
+
+    printf("%-22s avg %8.1f us (%9.0f cyc)  worst %7lu us  max err %.3f cents  mismatches %lu\n",
+           name,
+           avgUs,
+           avgUs * cyclesPerUs,
+           static_cast<unsigned long>(result.worstUs),
+           result.maxCentsError,
+           static_cast<unsigned long>(result.validityMismatches));
+}
+
+/**
+ * @brief Compute the reference estimates (Direct YIN) for every corpus frame
+ */
+static void buildReference() {
+    PitchDetectorYin reference(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE);
+
+    for (size_t index = 0; index < CORPUS_SIZE; ++index) {
+        synthesizePluck(corpusFrequency(index), index);
+        g_reference[index] = reference.estimate(g_frame.data(), PITCH_FRAME_SIZE);
+    }
+}
+
+static void benchmarkYinDifference() {
+    PitchDetectorYin direct(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                            PitchDetectorYin::DifferenceMethod::Direct);
+    PitchDetectorYin fft(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                         PitchDetectorYin::DifferenceMethod::Fft);
+    PitchDetectorYin fused(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                           PitchDetectorYin::DifferenceMethod::Fused);
+
+    printResult("YIN direct", measure([&](const float* s, size_t n) {
+        return direct.estimate(s, n);
+    }));
+    printResult("YIN fft", measure([&](const float* s, size_t n) {
+        return fft.estimate(s, n);
+    }));
+    // Same result as direct; avg/worst vs. the direct row give the early-exit savings
+    printResult("YIN fused", measure([&](const float* s, size_t n) {
+        return fused.estimate(s, n);
+    }));
+}
+
+/**
+ * @brief Coarse decimated search + full-rate refinement vs. single resolution
+ */
+static void benchmarkYinMultiRes() {
+    PitchDetectorYinMultiRes half(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f, 2);
+    PitchDetectorYinMultiRes quarter(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f, 4);
+
+    printResult("YIN multires x2", measure([&](const float* s, size_t n) {
+        return half.estimate(s, n);
+    }));
+    printResult("YIN multires x4", measure([&](const float* s, size_t n) {
+        return quarter.estimate(s, n);
+    }));
+}
+
+static void benchmarkYinFixed() {
+    PitchDetectorYinFixed fixed(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE);
+
+    // Runs on the quantized copy of the frame synthesized for 'measure'
+    printResult("YIN fixed (Q15)", measure([&](const float*, size_t n) {
+        return fixed.estimate(g_rawFrame.data(), n);
+    }));
+}
+
+/**
+ * @brief Time one string's detectors on that string's corpus frames
+ *
+ * Both run the string's AnalysisGeometry window (the newest samples of
+ * the frame, as StringProcessor does): the runtime class (which picks the
+ * specialized kernel for the matching geometry) and the exactly sized
+ * StaticPitchDetectorYin.
+ */
+template<StringId S>
+static void measureGeometry(BenchmarkResult& runtimeResult, BenchmarkResult& staticResult) {
+    constexpr AnalysisGeometry geometry = AnalysisGeometry::forString(S);
+    constexpr size_t offset = PITCH_FRAME_SIZE - geometry.windowSize;
+
+    PitchDetectorYin runtime(SAMPLE_RATE_HZ, geometry.windowSize,
+                             geometry.minFreq, geometry.maxFreq);
+    StringPitchDetectorYin<S> exact;
+
+    size_t first = static_cast<size_t>(S) * NUM_CORPUS_FRETS;
+
+    for (size_t index = first; index < first + NUM_CORPUS_FRETS; ++index) {
+        synthesizePluck(corpusFrequency(index), index);
+        const float* window = g_frame.data() + offset;
+
+        PitchEstimate ref = runtime.estimate(window, geometry.windowSize);
+
+        for (uint32_t r = 0; r < REPEATS; ++r) {
+            uint32_t start = Timer::getTimeMicros();
+            runtime.estimate(window, geometry.windowSize);
+            uint32_t runtimeUs = Timer::getElapsedMicros(start);
+
+            start = Timer::getTimeMicros();
+            PitchEstimate got = exact.estimate(window);
+            uint32_t staticUs = Timer::getElapsedMicros(start);
+
+            accumulate(runtimeResult, runtimeUs, ref, ref);
+            accumulate(staticResult, staticUs, ref, got);
+        }
+    }
+}
+
+/**
+ * @brief Per-string geometry: runtime wrapper vs compile-time detector
+ *
+ * Compare against "YIN direct" (one 30-400 Hz, full-frame configuration
+ * for every string) for the combined effect of geometry and specialization.
+ */
+static void benchmarkYinStatic() {
+    BenchmarkResult runtimeResult;
+    BenchmarkResult staticResult;
+
+    measureGeometry<StringId::E>(runtimeResult, staticResult);
+    measureGeometry<StringId::A>(runtimeResult, staticResult);
+    measureGeometry<StringId::D>(runtimeResult, staticResult);
+    measureGeometry<StringId::G>(runtimeResult, staticResult);
+
+    printResult("YIN per-string", runtimeResult);
+    printResult("YIN per-string static", staticResult);
+}
+
+// Hops slid from each pluck onset by the onset benchmark
+static constexpr uint32_t ONSET_HOPS = 24;
+
+/**
+ * @brief Onset-to-stable latency and octave errors of one detector
+ */
+struct OnsetResult {
+    BenchmarkResult timing;
+    uint32_t latencySamples = 0; // Summed over plucks that stabilized
+    uint32_t stabilized = 0;     // Plucks that reached a stable estimate
+    uint32_t estimates = 0;      // Valid estimates
+    uint32_t octaveErrors = 0;   // Valid estimates > 600 cents off
+};
+
+/**
+ * @brief Slide one detector across a pluck from its onset
+ *
+ * The window ends one hop later each step. The first of STABLE_ESTIMATES
+ * consecutive estimates within STABLE_CENTS of the true pitch marks the
+ * latency (window end relative to the onset).
+ */
+static void measureOnset(PitchDetector& detector, size_t windowSize, float frequency,
+                         OnsetResult& result) {
+    static constexpr uint32_t STABLE_ESTIMATES = 3;
+    static constexpr float STABLE_CENTS = 20.0f;
+
+    float frameSeconds = static_cast<float>(PITCH_FRAME_SIZE) / static_cast<float>(SAMPLE_RATE_HZ);
+    uint32_t stableRun = 0;
+    bool stabilized = false;
+
+    detector.reset();
+
+    for (uint32_t hop = 1; hop <= ONSET_HOPS; ++hop) {
+        uint32_t endSample = hop * PITCH_HOP_SIZE;
+        float endTime = static_cast<float>(endSample) / static_cast<float>(SAMPLE_RATE_HZ);
+        synthesizePluckAt(frequency, endTime - frameSeconds);
+
+        const float* window = g_frame.data() + PITCH_FRAME_SIZE - windowSize;
+
+        uint32_t start = Timer::getTimeMicros();
+        PitchEstimate got = detector.estimate(window, windowSize, PITCH_HOP_SIZE);
+        uint32_t elapsed = Timer::getElapsedMicros(start);
+
+        result.timing.totalUs += elapsed;
+        result.timing.worstUs = std::max(result.timing.worstUs, elapsed);
+
+        bool stable = false;
+        if (got.isValid() && got.confidence >= MIN_PITCH_CONFIDENCE) {
+            float cents = std::fabs(1200.0f * std::log2(got.frequencyHz / frequency));
+            result.estimates++;
+            if (cents > 600.0f) {
+                result.octaveErrors++;
+            }
+            stable = cents <= STABLE_CENTS;
+        }
+
+        stableRun = stable ? stableRun + 1 : 0;
+        if (stableRun == STABLE_ESTIMATES && !stabilized) {
+            result.latencySamples += endSample - (STABLE_ESTIMATES - 1) * PITCH_HOP_SIZE;
+            result.stabilized++;
+            stabilized = true;
+        }
+    }
+}
+
+static void printOnsetResult(const char* name, const OnsetResult& result, uint32_t frames) {
+    float avgUs = static_cast<float>(result.timing.totalUs) / static_cast<float>(frames);
+    float latencyMs = (result.stabilized == 0) ? 0.0f
+        : 1000.0f * static_cast<float>(result.latencySamples)
+          / static_cast<float>(result.stabilized * SAMPLE_RATE_HZ);
+
+    printf("%-22s avg %8.1f us  worst %7lu us  stable after %5.1f ms (%lu/%u)  octave errors %lu/%lu\n",
+           name,
+           avgUs,
+           static_cast<unsigned long>(result.timing.worstUs),
+           latencyMs,
+           static_cast<unsigned long>(result.stabilized),
+           static_cast<unsigned>(CORPUS_SIZE),
+           static_cast<unsigned long>(result.octaveErrors),
+           static_cast<unsigned long>(result.estimates));
+}
+
+/**
+ * @brief YIN vs. MPM on per-string windows, from the pluck onset
+ */
+static void benchmarkMpm() {
+    OnsetResult yinResult;
+    OnsetResult mpmResult;
+
+    for (size_t index = 0; index < CORPUS_SIZE; ++index) {
+        StringId string = static_cast<StringId>(index / NUM_CORPUS_FRETS);
+        AnalysisGeometry yinGeometry = AnalysisGeometry::forString(string);
+        AnalysisGeometry mpmGeometry = AnalysisGeometry::forString(
+            string, SAMPLE_RATE_HZ, PitchDetectorMpm::MPM_WINDOW_PERIODS);
+
+        PitchDetectorYin yin(SAMPLE_RATE_HZ, yinGeometry.windowSize,
+                             yinGeometry.minFreq, yinGeometry.maxFreq,
+                             PitchDetectorYin::DifferenceMethod::Fft);
+        PitchDetectorMpm mpm(SAMPLE_RATE_HZ, mpmGeometry.windowSize,
+                             mpmGeometry.minFreq, mpmGeometry.maxFreq);
+
+        float frequency = corpusFrequency(index);
+        measureOnset(yin, yinGeometry.windowSize, frequency, yinResult);
+        measureOnset(mpm, mpmGeometry.windowSize, frequency, mpmResult);
+    }
+
+    uint32_t frames = CORPUS_SIZE * ONSET_HOPS;
+    printOnsetResult("YIN onset", yinResult, frames);
+    printOnsetResult("MPM onset", mpmResult, frames);
+}
+
+/**
+ * @brief Slide a window through each corpus pluck one hop at a time
+ *
+ * Compares the Incremental difference update and lag tracking against a
+ * full Fft recompute on the same overlapping windows. Each detector slides
+ * through a whole pluck before the next one starts: Incremental keeps
+ * d(tau) in the shared ScratchArena, which interleaved estimates from the
+ * other detectors would overwrite (forcing a full recompute every hop).
+ */
+static void benchmarkYinSliding() {
+    static constexpr uint32_t HOPS_PER_PLUCK = 32;
+    float hopSeconds = static_cast<float>(PITCH_HOP_SIZE) / static_cast<float>(SAMPLE_RATE_HZ);
+
+    PitchDetectorYin fft(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                         PitchDetectorYin::DifferenceMethod::Fft);
+    PitchDetectorYin incremental(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                                 PitchDetectorYin::DifferenceMethod::Incremental);
+    PitchDetectorYin tracking(SAMPLE_RATE_HZ, PITCH_FRAME_SIZE, 30.0f, 400.0f,
+                              PitchDetectorYin::DifferenceMethod::Fft);
+    tracking.setTrackingEnabled(true);
+
+    BenchmarkResult fftResult;
+    BenchmarkResult incrementalResult;
+    BenchmarkResult trackingResult;
+
+    std::array<PitchEstimate, HOPS_PER_PLUCK> reference;
+
+    for (size_t index = 0; index < CORPUS_SIZE; ++index) {
+        float frequency = corpusFrequency(index);
+        incremental.reset();
+        tracking.reset();
+
+        for (uint32_t hop = 0; hop < HOPS_PER_PLUCK; ++hop) {
+            synthesizePluckAt(frequency, hopSeconds * static_cast<float>(hop));
+
+            uint32_t start = Timer::getTimeMicros();
+            reference[hop] = fft.estimate(g_frame.data(), PITCH_FRAME_SIZE);
+            accumulate(fftResult, Timer::getElapsedMicros(start), reference[hop], reference[hop]);
+        }
+
+        for (PitchDetectorYin* detector : {&incremental, &tracking}) {
+            BenchmarkResult& result = (detector == &incremental) ? incrementalResult
+                                                                 : trackingResult;
+
+            for (uint32_t hop = 0; hop < HOPS_PER_PLUCK; ++hop) {
+                synthesizePluckAt(frequency, hopSeconds * static_cast<float>(hop));
+                size_t hopSize = (hop == 0) ? 0 : PITCH_HOP_SIZE;
+
+                uint32_t start = Timer::getTimeMicros();
+                PitchEstimate got = detector->estimate(g_frame.data(), PITCH_FRAME_SIZE, hopSize);
+                accumulate(result, Timer::getElapsedMicros(start), reference[hop], got);
+            }
+        }
+    }
+
+    uint32_t frames = CORPUS_SIZE * HOPS_PER_PLUCK;
+    printResult("YIN fft (sliding)", fftResult, frames);
+    printResult("YIN incremental", incrementalResult, frames);
+    printResult("YIN tracking", trackingResult, frames);
+}
+
+/**
+ * @brief Time one ring buffer class: per-sample pushes, span drain per hop
+ * @return Total microseconds for all hops
+ */
+template<typename Ring>
+static uint32_t measureRing(Ring& ring, uint32_t hops, uint32_t& checksum) {
+    uint32_t start = Timer::getTimeMicros();
+
+    for (uint32_t hop = 0; hop < hops; ++hop) {
+        // Producer: one push per sample, as the timer ISR does
+        for (size_t i = 0; i < PITCH_HOP_SIZE; ++i) {
+            ring.push(g_rawFrame[i]);
+        }
+
+        // Consumer: in-place drain, as StringProcessor::process() does
+        auto spans = ring.readSpans(PITCH_HOP_SIZE);
+        for (size_t i = 0; i < spans.firstSize; ++i) {
+            checksum += spans.first[i];
+        }
+        for (size_t i = 0; i < spans.secondSize; ++i) {
+            checksum += spans.second[i];
+        }
+        ring.consume(spans.size());
+    }
+
+    return Timer::getElapsedMicros(start);
+}
+
+/**
+ * @brief Sample handoff cost: volatile RingBuffer vs. atomic SpscRingBuffer
+ */
+static void benchmarkRingBuffer() {
+    static constexpr uint32_t HOPS = 1000;
+    static RingBuffer<uint16_t, RING_BUFFER_SIZE> ring;
+    static SpscRingBuffer<uint16_t, RING_BUFFER_SIZE> spsc;
+
+    synthesizePluck(NoteMapping::getOpenStringFrequency(StringId::E), 0);
+
+    uint32_t checksum = 0;
+    uint32_t ringUs = measureRing(ring, HOPS, checksum);
+    uint32_t spscUs = measureRing(spsc, HOPS, checksum);
+
+    float samples = static_cast<float>(HOPS * PITCH_HOP_SIZE);
+    float cyclesPerUs = static_cast<float>(clock_get_hz(clk_sys)) / 1.0e6f;
+
+    printf("%-22s %6.1f cyc/sample\n", "RingBuffer (volatile)",
+           static_cast<float>(ringUs) * cyclesPerUs / samples);
+    printf("%-22s %6.1f cyc/sample  (checksum %lu)\n", "SpscRingBuffer",
+           static_cast<float>(spscUs) * cyclesPerUs / samples,
+           static_cast<unsigned long>(checksum));
+}
+
+/**
+ * @brief Stand-in for App as an ADC sink: one ring buffer per string
+ */
+struct BenchmarkAdcSink {
+    std::array<SpscRingBuffer<uint16_t, RING_BUFFER_SIZE>, NUM_STRINGS> rings;
+
+    void onAdcSample(StringId string, uint16_t sample) {
+        rings[static_cast<uint8_t>(string)].push(sample);
+    }
+
+    void drain() {
+        for (auto& ring : rings) {
+            ring.consume(ring.getAvailable());
+        }
+    }
+};
+
+/**
+ * @brief Timer-mode ISR body without the conversions: one frame per call
+ * @param dispatch Called as dispatch(StringId, sample), like the driver's sink
+ */
+template<typename Dispatch>
+static void adcIsrFrame(size_t frame, Dispatch&& dispatch) {
+    for (uint8_t channel = 0; channel < NUM_STRINGS; ++channel) {
+        dispatch(static_cast<StringId>(channel), g_rawFrame[(frame + channel) % PITCH_FRAME_SIZE]);
+    }
+}
+
+/**
+ * @brief Per-sample ISR dispatch: std::function callback vs. AdcDriver<Sink>
+ */
+static void benchmarkAdcSink() {
+    static constexpr uint32_t FRAMES = 8000; // One second of timer ticks
+    static BenchmarkAdcSink sink;
+
+    synthesizePluck(NoteMapping::getOpenStringFrequency(StringId::E), 0);
+
+    // Before: type-erased callback, as AdcDriver::SampleCallback was
+    std::function<void(StringId, uint16_t)> callback =
+        [](StringId string, uint16_t sample) { sink.onAdcSample(string, sample); };
+
+    uint32_t start = Timer::getTimeMicros();
+    for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+        adcIsrFrame(frame, callback);
+        if (frame % PITCH_HOP_SIZE == 0) {
+            sink.drain();
+        }
+    }
+    uint32_t functionUs = Timer::getElapsedMicros(start);
+
+    // After: the sink is a template parameter and inlines
+    start = Timer::getTimeMicros();
+    for (uint32_t frame = 0; frame < FRAMES; ++frame) {
+        adcIsrFrame(frame, [](StringId string, uint16_t sample) {
+            sink.onAdcSample(string, sample);
+        });
+        if (frame % PITCH_HOP_SIZE == 0) {
+            sink.drain();
+        }
+    }
+    uint32_t templateUs = Timer::getElapsedMicros(start);
+
+    float cyclesPerUs = static_cast<float>(clock_get_hz(clk_sys)) / 1.0e6f;
+    printf("%-22s %6.1f cyc/frame (4 samples, excl. conversions)\n", "ADC ISR std::function",
+           static_cast<float>(functionUs) * cyclesPerUs / FRAMES);
+    printf("%-22s %6.1f cyc/frame (4 samples, excl. conversions)\n", "ADC ISR template sink",
+           static_cast<float>(templateUs) * cyclesPerUs / FRAMES);
+}
+
+void Benchmark::run() {
+    printf("--- DSP benchmark (%u frames x %lu repeats, %lu samples @ %lu Hz) ---\n",
+           static_cast<unsigned>(CORPUS_SIZE),
+           static_cast<unsigned long>(REPEATS),
+           static_cast<unsigned long>(PITCH_FRAME_SIZE),
+           static_cast<unsigned long>(SAMPLE_RATE_HZ));
+
+    buildReference();
+    benchmarkYinDifference();
+    benchmarkYinMultiRes();
+    benchmarkYinFixed();
+    benchmarkYinStatic();
+    benchmarkMpm();
+    benchmarkYinSliding();
+    benchmarkRingBuffer();
+    benchmarkAdcSink();
+
+    printf("--- Benchmark complete ---\n");
+}
+
+} // namespace BassMINT
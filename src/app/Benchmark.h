@@ -0,0 +1,25 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief On-target DSP benchmarks (BASSMINT_BENCHMARK builds only)
+ *
+ * Runs each pitch detection path over a corpus of synthetic bass plucks
+ * (every string, frets 0-24) and prints per-frame time, approximate CPU
+ * cycles and deviation from the reference Direct YIN loop over USB serial.
+ *
+ * Called once from main() before the application starts.
+ */
+class Benchmark {
+public:
+    /**
+     * @brief Run all benchmarks and print results (blocking)
+     */
+    static void run();
+};
+
+} // namespace BassMINT
@@ -0,0 +1,64 @@
+#pragma once
+
+#include "app/NoteEventSink.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Records bus events into a fixed array (host tests)
+ *
+ * Keeps the first Capacity events in order and counts the rest, so a test
+ * can subscribe it next to the real outputs and compare what StringManager
+ * decided with what left on the wire. No allocation, no hardware access.
+ *
+ * @tparam Capacity Events kept
+ */
+template<size_t Capacity>
+class MemoryEventSink : public NoteEventSink {
+public:
+    void consume(const NoteEvent* events, size_t count) override {
+        for (size_t i = 0; i < count; ++i) {
+            if (size_ < Capacity) {
+                events_[size_++] = events[i];
+            } else {
+                overflow_++;
+            }
+        }
+    }
+
+    void endBatch() override {
+        batches_++;
+    }
+
+    const NoteEvent& operator[](size_t index) const { return events_[index]; }
+    const NoteEvent* begin() const { return events_.data(); }
+    const NoteEvent* end() const { return events_.data() + size_; }
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Events that did not fit
+     */
+    uint32_t getOverflow() const { return overflow_; }
+
+    /**
+     * @brief Number of endBatch() calls (bus dispatches)
+     */
+    uint32_t getBatches() const { return batches_; }
+
+    void clear() {
+        size_ = 0;
+        overflow_ = 0;
+        batches_ = 0;
+    }
+
+private:
+    std::array<NoteEvent, Capacity> events_;
+    size_t size_ = 0;
+    uint32_t overflow_ = 0;
+    uint32_t batches_ = 0;
+};
+
+} // namespace BassMINT
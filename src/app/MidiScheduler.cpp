@@ -0,0 +1,190 @@
+#include "app/MidiScheduler.h"
+#include "core/MidiEvents.h"
+
+namespace BassMINT {
+
+MidiScheduler::MidiScheduler(MidiDinOut& midiOut)
+    : midiOut_(midiOut)
+    , nextSequence_(0)
+    , coalescedSysEx_(0)
+    , sentBends_(0)
+    , coalescedBends_(0)
+    , sysExBundles_(false)
+    , fretSysEx_(true)
+{
+}
+
+void MidiScheduler::consume(const NoteEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const NoteEvent& event = events[i];
+
+        switch (event.type) {
+            case NoteEvent::Type::NoteOn:
+                sendNoteOn(event.channel, event.note, event.velocity);
+                break;
+
+            case NoteEvent::Type::NoteOff:
+                sendNoteOff(event.channel, event.note, event.velocity);
+                break;
+
+            case NoteEvent::Type::PitchBend:
+                if (event.noteStart) {
+                    sendNoteBend(event.string, event.channel, event.bend);
+                } else {
+                    sendPitchBend(event.string, event.channel, event.bend);
+                }
+                break;
+
+            case NoteEvent::Type::Fret:
+                if (fretSysEx_) {
+                    sendFretSysEx(SysExEncoder::FretSysExPayload(
+                        event.string, event.fret, event.note, event.velocity));
+                }
+                break;
+
+            case NoteEvent::Type::MpeConfiguration:
+                // Ahead of everything, like notes: it changes their meaning
+                sendMpeConfiguration(midiOut_, event.channel, event.memberChannels);
+                break;
+        }
+    }
+}
+
+void MidiScheduler::sendNoteBend(StringId string, uint8_t channel, uint16_t value) {
+    uint8_t index = static_cast<uint8_t>(string);
+    if (index < NUM_STRINGS) {
+        bendSlots_[index].pending = false;
+    }
+
+    midiOut_.sendPitchBend(channel, value);
+    sentBends_++;
+}
+
+void MidiScheduler::sendPitchBend(StringId string, uint8_t channel, uint16_t value) {
+    uint8_t index = static_cast<uint8_t>(string);
+    if (index >= NUM_STRINGS) {
+        return;
+    }
+
+    BendSlot& slot = bendSlots_[index];
+
+    if (slot.pending) {
+        coalescedBends_++;
+    } else {
+        slot.sequence = nextSequence_++;
+        slot.pending = true;
+    }
+
+    slot.channel = channel;
+    slot.value = value;
+}
+
+void MidiScheduler::sendFretSysEx(const SysExEncoder::FretSysExPayload& payload) {
+    uint8_t index = static_cast<uint8_t>(payload.string);
+    if (index >= NUM_STRINGS) {
+        return;
+    }
+
+    SysExSlot& slot = sysExSlots_[index];
+
+    // Still waiting: the newer fret supersedes it, keeping its place
+    if (slot.pending) {
+        coalescedSysEx_++;
+    } else {
+        slot.sequence = nextSequence_++;
+        slot.pending = true;
+    }
+
+    slot.payload = payload;
+}
+
+void MidiScheduler::service() {
+    // Anything on the wire (notes, or the previous SysEx) goes first
+    if (!midiOut_.isTxIdle()) {
+        return;
+    }
+
+    if (sendBends()) {
+        return;
+    }
+
+    if (sysExBundles_) {
+        sendSysExBundle();
+    } else {
+        sendOldestSysEx();
+    }
+}
+
+bool MidiScheduler::sendBends() {
+    bool sent = false;
+
+    // Oldest first; at most one per string
+    while (true) {
+        BendSlot* oldest = nullptr;
+        for (BendSlot& slot : bendSlots_) {
+            if (slot.pending &&
+                (!oldest || static_cast<int32_t>(slot.sequence - oldest->sequence) < 0)) {
+                oldest = &slot;
+            }
+        }
+
+        if (!oldest) {
+            return sent;
+        }
+
+        midiOut_.sendPitchBend(oldest->channel, oldest->value);
+        oldest->pending = false;
+        sentBends_++;
+        sent = true;
+    }
+}
+
+void MidiScheduler::sendOldestSysEx() {
+    SysExSlot* oldest = nullptr;
+    for (SysExSlot& slot : sysExSlots_) {
+        if (!slot.pending) {
+            continue;
+        }
+        // Wrap-safe age comparison
+        if (!oldest || static_cast<int32_t>(slot.sequence - oldest->sequence) < 0) {
+            oldest = &slot;
+        }
+    }
+
+    if (!oldest) {
+        return;
+    }
+
+    auto message = SysExEncoder::encode(oldest->payload);
+    midiOut_.sendSysEx(message.data(), message.size());
+    oldest->pending = false;
+}
+
+void MidiScheduler::sendSysExBundle() {
+    std::array<SysExEncoder::FretSysExPayload, NUM_STRINGS> updates;
+    size_t count = 0;
+    for (SysExSlot& slot : sysExSlots_) {
+        if (slot.pending) {
+            updates[count++] = slot.payload;
+            slot.pending = false;
+        }
+    }
+
+    SysExEncoder::BundleMessage message;
+    size_t length = SysExEncoder::encodeBundle(updates.data(), count, message);
+    if (length > 0) {
+        midiOut_.sendSysEx(message.data(), length);
+    }
+}
+
+size_t MidiScheduler::getPendingSysEx() const {
+    size_t pending = 0;
+    for (const SysExSlot& slot : sysExSlots_) {
+        if (slot.pending) {
+            pending++;
+        }
+    }
+    return pending;
+}
+
+} // namespace BassMINT
@@ -0,0 +1,169 @@
+#pragma once
+
+#include "core/Types.h"
+#include "core/SysExEncoder.h"
+#include "app/NoteEventSink.h"
+#include "hal/MidiDinOut.h"
+#include <array>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief DIN output sink: orders outgoing MIDI by priority in front of MidiDinOut
+ *
+ * Subscribed to the NoteEventBus, it turns note events into DIN MIDI:
+ * NoteOn/NoteOff into note messages, PitchBend into bends, Fret into
+ * the BassMINT SysEx (unless disabled) and MpeConfiguration into RPN 6.
+ *
+ * MidiDinOut transmits strictly in order, so a Note On queued behind
+ * other strings' SysEx waits for all of it on the 31250-baud wire (a
+ * four-string change used to put ~40 bytes, 13 ms, ahead of the last
+ * Note On). Three priority classes fix that:
+ *
+ * 1. Note On/Off (and the MPE configuration): passed to MidiDinOut
+ *    immediately
+ * 2. Pitch bend (PerStringChannel mode): one slot per string, all waiting
+ *    bends released together by service() while the transmitter is idle
+ * 3. String SysEx: one slot per string, released by service() one message
+ *    at a time while the transmitter is idle and no bend is waiting
+ *
+ * So a note never waits behind more than what is already on the wire:
+ * one SysEx (10 bytes, 3.2 ms) or one bend per string (12 bytes, 3.8 ms).
+ * A bend or SysEx still waiting when a newer one for the same string
+ * arrives is replaced: only the latest value matters. That is also the
+ * bend rate limiter: bends go out at the pitch hop rate while the wire
+ * has room and thin out by themselves as note traffic takes it over.
+ *
+ * Waiting SysEx are released oldest first, or with bundling enabled all
+ * together as one version 2 frame (SysExEncoder::encodeBundle).
+ *
+ * Main loop only (core0 with BASSMINT_DUAL_CORE), like MidiDinOut.
+ */
+class MidiScheduler : public NoteEventSink {
+public:
+    /**
+     * @brief Constructor
+     * @param midiOut DIN output; must outlive the scheduler
+     */
+    explicit MidiScheduler(MidiDinOut& midiOut);
+
+    /**
+     * @brief Translate bus events into DIN MIDI (NoteEventSink)
+     */
+    void consume(const NoteEvent* events, size_t count) override;
+
+    /**
+     * @brief Send Note On ahead of any waiting SysEx
+     */
+    void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+        midiOut_.sendNoteOn(channel, note, velocity);
+    }
+
+    /**
+     * @brief Send Note Off ahead of any waiting SysEx
+     */
+    void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
+        midiOut_.sendNoteOff(channel, note, velocity);
+    }
+
+    /**
+     * @brief Send a note's starting pitch bend ahead of its Note On
+     *
+     * Replaces the string's waiting bend, which belonged to the old note.
+     */
+    void sendNoteBend(StringId string, uint8_t channel, uint16_t value);
+
+    /**
+     * @brief Queue a string's pitch bend (replaces one still waiting)
+     * @param string Slot to use
+     * @param channel MIDI channel (0-15)
+     * @param value 14-bit bend
+     */
+    void sendPitchBend(StringId string, uint8_t channel, uint16_t value);
+
+    /**
+     * @brief Queue a string's fret SysEx (replaces one still waiting)
+     * @param payload Fret update; payload.string selects the slot
+     */
+    void sendFretSysEx(const SysExEncoder::FretSysExPayload& payload);
+
+    /**
+     * @brief Send waiting SysEx as one version 2 bundle (default: version 1)
+     *
+     * Version 1 keeps one 10-byte message per string for existing receivers.
+     */
+    void setSysExBundles(bool enabled) { sysExBundles_ = enabled; }
+
+    /**
+     * @brief Check if waiting SysEx are bundled
+     */
+    bool isSysExBundles() const { return sysExBundles_; }
+
+    /**
+     * @brief Send Fret events as BassMINT SysEx (default on)
+     *
+     * With per-string channels the channel already identifies the string.
+     */
+    void setFretSysEx(bool enabled) { fretSysEx_ = enabled; }
+
+    /**
+     * @brief Release waiting SysEx if the transmitter is idle
+     *
+     * Waiting bends first (all of them), else SysEx. Version 1: the
+     * oldest one. Bundles: all of them in one frame.
+     *
+     * Call once per main loop pass.
+     */
+    void service();
+
+    /**
+     * @brief Number of SysEx waiting for the wire
+     */
+    size_t getPendingSysEx() const;
+
+    /**
+     * @brief SysEx replaced by a newer one before they were sent
+     */
+    uint32_t getCoalescedSysEx() const { return coalescedSysEx_; }
+
+    /**
+     * @brief Pitch bends sent
+     */
+    uint32_t getSentBends() const { return sentBends_; }
+
+    /**
+     * @brief Pitch bends replaced by a newer one before they were sent
+     */
+    uint32_t getCoalescedBends() const { return coalescedBends_; }
+
+private:
+    struct SysExSlot {
+        SysExEncoder::FretSysExPayload payload;
+        uint32_t sequence = 0; // Arrival order, for oldest-first release
+        bool pending = false;
+    };
+
+    struct BendSlot {
+        uint8_t channel = 0;
+        uint16_t value = PITCH_BEND_CENTER;
+        uint32_t sequence = 0;
+        bool pending = false;
+    };
+
+    bool sendBends();
+    void sendOldestSysEx();
+    void sendSysExBundle();
+
+    MidiDinOut& midiOut_;
+    std::array<SysExSlot, NUM_STRINGS> sysExSlots_;
+    std::array<BendSlot, NUM_STRINGS> bendSlots_;
+    uint32_t nextSequence_;
+    uint32_t coalescedSysEx_;
+    uint32_t sentBends_;
+    uint32_t coalescedBends_;
+    bool sysExBundles_;
+    bool fretSysEx_;
+};
+
+} // namespace BassMINT
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/NoteEvent.h"
+#include "app/NoteEventSink.h"
+#include "dsp/SpscRingBuffer.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Fixed-capacity note event queue fanned out to pluggable sinks
+ *
+ * StringManagers publish NoteEvents without knowing where they go;
+ * dispatch() hands every queued event to every subscribed sink (DIN,
+ * USB-MIDI, a trace or test recorder), so adding a transport means adding
+ * a sink instead of editing app logic.
+ *
+ * - Events live in an SpscRingBuffer: publish() is lock-free and never
+ *   blocks; when full the new event is dropped and counted (the queue
+ *   holds several ticks' worth, so this only happens if dispatch() stops)
+ * - dispatch() passes the queued events as at most two contiguous runs
+ *   straight out of the ring (no copy), then calls endBatch() on each sink
+ * - Sinks are registered once at init, up to MAX_SINKS
+ *
+ * Producer and consumer follow SpscRingBuffer's rules: publish() from one
+ * context, dispatch() from one other context or the same one.
+ *
+ * @tparam Capacity Events the queue holds (power of 2)
+ */
+template<size_t Capacity>
+class NoteEventBus {
+public:
+    static constexpr size_t CAPACITY = Capacity;
+    static constexpr size_t MAX_SINKS = 4;
+
+    /**
+     * @brief Register a sink (init only, before the first dispatch)
+     * @return false if MAX_SINKS are already registered
+     */
+    bool subscribe(NoteEventSink& sink) {
+        if (sinkCount_ >= MAX_SINKS) {
+            return false;
+        }
+        sinks_[sinkCount_++] = &sink;
+        return true;
+    }
+
+    /**
+     * @brief Queue an event (producer)
+     * @return true if queued, false if dropped
+     */
+    bool publish(const NoteEvent& event) {
+        if (!events_.push(event)) {
+            droppedEvents_++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Deliver all queued events to every sink (consumer)
+     * @return Number of events delivered
+     */
+    size_t dispatch() {
+        auto spans = events_.readSpans(Capacity);
+        size_t count = spans.size();
+
+        if (count > 0) {
+            for (size_t i = 0; i < sinkCount_; ++i) {
+                if (spans.firstSize > 0) {
+                    sinks_[i]->consume(spans.first, spans.firstSize);
+                }
+                if (spans.secondSize > 0) {
+                    sinks_[i]->consume(spans.second, spans.secondSize);
+                }
+            }
+            events_.consume(count);
+        }
+
+        for (size_t i = 0; i < sinkCount_; ++i) {
+            sinks_[i]->endBatch();
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief Events waiting for dispatch() (consumer)
+     */
+    size_t getPending() const { return events_.getAvailable(); }
+
+    /**
+     * @brief Events dropped on a full queue
+     */
+    uint32_t getDroppedEvents() const { return droppedEvents_; }
+
+private:
+    SpscRingBuffer<NoteEvent, Capacity> events_;
+    std::array<NoteEventSink*, MAX_SINKS> sinks_ = {};
+    size_t sinkCount_ = 0;
+    uint32_t droppedEvents_ = 0;
+};
+
+// Four strings × (Note Off, bend, Note On, fret) per tick, with room to spare
+constexpr size_t NOTE_EVENT_BUS_SIZE = 64;
+
+using NoteBus = NoteEventBus<NOTE_EVENT_BUS_SIZE>;
+
+} // namespace BassMINT
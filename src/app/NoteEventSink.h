@@ -0,0 +1,36 @@
+#pragma once
+
+#include "core/NoteEvent.h"
+#include <cstddef>
+
+namespace BassMINT {
+
+/**
+ * @brief Consumer of the NoteEventBus (one per output transport)
+ *
+ * The bus hands each sink every event in order, in contiguous runs, and
+ * calls endBatch() once the bus is empty. A sink packs the run into its
+ * transport's natural unit (DIN: prioritized MIDI messages and SysEx
+ * bundles, USB: event packets per bulk transfer, trace: lines) and sends
+ * whatever is left over in endBatch().
+ *
+ * Called from the bus' consumer context (App::tick() on core0).
+ */
+class NoteEventSink {
+public:
+    virtual ~NoteEventSink() = default;
+
+    /**
+     * @brief Take a run of events (oldest first)
+     * @param events Events; only valid during the call
+     * @param count Number of events (at least 1)
+     */
+    virtual void consume(const NoteEvent* events, size_t count) = 0;
+
+    /**
+     * @brief All events published so far were delivered
+     */
+    virtual void endBatch() {}
+};
+
+} // namespace BassMINT
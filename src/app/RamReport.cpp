@@ -0,0 +1,47 @@
+/**
+ * @file RamReport.cpp
+ * @brief Per-component RAM sizes for the build-time report
+ *
+ * Built as its own library and never linked into the firmware. Each array
+ * below is exactly as large as the component it names, as laid out by the
+ * target compiler with the firmware's build options; cmake/RamReport.cmake
+ * reads them back with nm after every build and prints them next to the
+ * linked .bss/.data total.
+ */
+
+#include "app/App.h"
+#include "dsp/ScratchArena.h"
+#include <variant>
+
+using namespace BassMINT;
+
+extern "C" {
+
+// Everything the application owns (static storage, see main.cpp)
+char bassmint_ram_App[sizeof(App)];
+
+// Inside App
+char bassmint_ram_AdcDriver[sizeof(AdcDriver<App>)];
+char bassmint_ram_MidiDinOut[sizeof(MidiDinOut)];
+char bassmint_ram_MidiScheduler[sizeof(MidiScheduler)];
+char bassmint_ram_NoteBus[sizeof(NoteBus)];
+#ifdef BASSMINT_USB_MIDI
+char bassmint_ram_UsbMidiOut[sizeof(UsbMidiOut)];
+#endif
+char bassmint_ram_LedDriver[sizeof(LedDriver)];
+char bassmint_ram_StringProcessor_x4[NUM_STRINGS * sizeof(StringProcessor)];
+char bassmint_ram_StringManager_x4[NUM_STRINGS * sizeof(StringManager)];
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+// Inside StringProcessor_x4: the detector slot, sized for the larger
+// alternative whichever detector a string selects
+char bassmint_ram_PitchDetector_x4[NUM_STRINGS * sizeof(std::variant<PitchDetectorYin, PitchDetectorMpm>)];
+#endif
+
+// Shared by all strings (dsp/ScratchArena.cpp)
+char bassmint_ram_ScratchArena[ScratchArena::TOTAL_BYTES];
+
+// What per-string copies of the scratch buffers would add on top
+char bassmint_ram_saved_by_sharing[(NUM_STRINGS - 1) * ScratchArena::TOTAL_BYTES];
+
+} // extern "C"
@@ -0,0 +1,74 @@
+#include "app/StreamEventSink.h"
+
+namespace BassMINT {
+
+static const char* const STRING_NAMES[NUM_STRINGS] = {"E", "A", "D", "G"};
+
+StreamEventSink::StreamEventSink(FILE* stream)
+    : stream_(stream)
+    , length_(0)
+    , writtenEvents_(0)
+{
+}
+
+void StreamEventSink::consume(const NoteEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const NoteEvent& event = events[i];
+
+        if (BUFFER_SIZE - length_ < MAX_LINE) {
+            writeBuffer();
+        }
+
+        uint8_t index = static_cast<uint8_t>(event.string);
+        const char* name = (index < NUM_STRINGS) ? STRING_NAMES[index] : "?";
+        unsigned long time = static_cast<unsigned long>(event.timestampUs);
+        unsigned channel = event.channel + 1u;
+        char* line = buffer_ + length_;
+        int written = 0;
+
+        switch (event.type) {
+            case NoteEvent::Type::NoteOn:
+                written = snprintf(line, MAX_LINE, "%lu on   %s ch%u note=%u vel=%u\n",
+                                   time, name, channel, event.note, event.velocity);
+                break;
+            case NoteEvent::Type::NoteOff:
+                written = snprintf(line, MAX_LINE, "%lu off  %s ch%u note=%u vel=%u\n",
+                                   time, name, channel, event.note, event.velocity);
+                break;
+            case NoteEvent::Type::PitchBend:
+                written = snprintf(line, MAX_LINE, "%lu bend %s ch%u %u%s\n",
+                                   time, name, channel, event.bend,
+                                   event.noteStart ? " start" : "");
+                break;
+            case NoteEvent::Type::Fret:
+                written = snprintf(line, MAX_LINE, "%lu fret %s ch%u fret=%d note=%u vel=%u\n",
+                                   time, name, channel, event.fret, event.note, event.velocity);
+                break;
+            case NoteEvent::Type::MpeConfiguration:
+                written = snprintf(line, MAX_LINE, "%lu mpe  ch%u members=%u\n",
+                                   time, channel, event.memberChannels);
+                break;
+        }
+
+        if (written > 0) {
+            length_ += (static_cast<size_t>(written) < MAX_LINE)
+                ? static_cast<size_t>(written) : MAX_LINE - 1;
+            writtenEvents_++;
+        }
+    }
+
+    writeBuffer();
+}
+
+void StreamEventSink::endBatch() {
+    fflush(stream_);
+}
+
+void StreamEventSink::writeBuffer() {
+    if (length_ > 0 && stream_) {
+        fwrite(buffer_, 1, length_, stream_);
+    }
+    length_ = 0;
+}
+
+} // namespace BassMINT
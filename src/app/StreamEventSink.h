@@ -0,0 +1,49 @@
+#pragma once
+
+#include "app/NoteEventSink.h"
+#include <cstdio>
+
+namespace BassMINT {
+
+/**
+ * @brief Writes bus events as text lines to a stdio stream
+ *
+ * One line per event, one write per event run, e.g.:
+ *
+ *   12345678 on   E ch1 note=33 vel=100
+ *   12345678 fret E ch1 fret=5 note=33 vel=100
+ *   12361678 bend E ch2 8200
+ *
+ * A file on the host (event traces for tests and tuning) or stdout on the
+ * device (USB serial). Lines are collected in a fixed buffer and written
+ * once per event run; the stream is flushed at the end of each dispatch.
+ */
+class StreamEventSink : public NoteEventSink {
+public:
+    /**
+     * @brief Constructor
+     * @param stream Open stream; must outlive the sink
+     */
+    explicit StreamEventSink(FILE* stream);
+
+    void consume(const NoteEvent* events, size_t count) override;
+    void endBatch() override;
+
+    /**
+     * @brief Events written
+     */
+    uint32_t getWrittenEvents() const { return writtenEvents_; }
+
+private:
+    static constexpr size_t BUFFER_SIZE = 512;
+    static constexpr size_t MAX_LINE = 64;
+
+    void writeBuffer();
+
+    FILE* stream_;
+    char buffer_[BUFFER_SIZE];
+    size_t length_;
+    uint32_t writtenEvents_;
+};
+
+} // namespace BassMINT
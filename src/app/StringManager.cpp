@@ -4,29 +4,45 @@
 
 namespace BassMINT {
 
-StringManager::StringManager(StringId stringId, MidiDinOut& midiOut)
+StringManager::StringManager(StringId stringId, NoteBus& bus)
     : stringId_(stringId)
-    , midiOut_(midiOut)
+    , bus_(bus)
+    , outputMode_(MidiOutputMode::SingleChannel)
+    , channel_(MIDI_CHANNEL)
+    , reportTimeUs_(0)
     , noteOn_(false)
     , currentMidiNote_(0)
     , currentFret_(-1)
     , fretChangeCounter_(0)
     , pendingFret_(-1)
+    , lastBend_(PITCH_BEND_CENTER)
 {
 }
 
-void StringManager::update(const StringProcessor& processor) {
-    // Check if processor matches our string
-    if (processor.getStringId() != stringId_) {
+void StringManager::setOutputMode(MidiOutputMode mode) {
+    // The sounding note must end on the channel it started on
+    sendNoteOff();
+
+    outputMode_ = mode;
+    channel_ = (mode == MidiOutputMode::PerStringChannel)
+        ? static_cast<uint8_t>(MPE_FIRST_MEMBER_CHANNEL + static_cast<uint8_t>(stringId_))
+        : MIDI_CHANNEL;
+}
+
+void StringManager::update(const StringReport& report) {
+    // Check if report matches our string
+    if (report.string != stringId_) {
         return; // Wrong string
     }
 
-    StringState state = processor.getState();
-    const PitchEstimate& pitch = processor.getLatestPitch();
+    reportTimeUs_ = report.timestampUs;
+
+    StringState state = report.state;
+    const PitchEstimate& pitch = report.pitch;
 
     // Map pitch to fret
     FretPosition currentFretPos;
-    if (pitch.isValid() && processor.isActive()) {
+    if (pitch.isValid() && report.isActive()) {
         currentFretPos = NoteMapping::mapPitchToFret(stringId_, pitch);
     }
 
@@ -56,6 +72,11 @@ void StringManager::update(const StringProcessor& processor) {
                     handleAttack(currentFretPos);
                 }
 
+                // Slides and vibrato between (or before) fret changes
+                if (noteOn_ && outputMode_ == MidiOutputMode::PerStringChannel) {
+                    updatePitchBend(pitch.frequencyHz);
+                }
+
                 // Update last valid fret
                 lastValidFret_ = currentFretPos;
             }
@@ -114,13 +135,17 @@ void StringManager::handleFretChange(const FretPosition& newFretPos) {
 void StringManager::sendNoteOn(const FretPosition& fretPos) {
     uint8_t midiNote = NoteMapping::fretToMidiNote(fretPos.string, fretPos.fret);
 
-    // Send MIDI Note On
-    midiOut_.sendNoteOn(MIDI_CHANNEL, midiNote, DEFAULT_VELOCITY);
+    // The note starts at the detected pitch, not the fret's nominal one
+    if (outputMode_ == MidiOutputMode::PerStringChannel) {
+        lastBend_ = NoteMapping::frequencyToPitchBend(fretPos.frequency, midiNote,
+                                                      MPE_PITCH_BEND_RANGE);
+        bus_.publish(NoteEvent::pitchBend(stringId_, channel_, lastBend_, true, reportTimeUs_));
+    }
 
-    // Send BassMINT SysEx
-    auto sysexPayload = SysExEncoder::fromFretPosition(fretPos, DEFAULT_VELOCITY);
-    auto sysexMsg = SysExEncoder::encode(sysexPayload);
-    midiOut_.sendSysEx(sysexMsg.data(), sysexMsg.size());
+    bus_.publish(NoteEvent::noteOn(stringId_, channel_, midiNote, DEFAULT_VELOCITY,
+                                   reportTimeUs_));
+    bus_.publish(NoteEvent::fretChange(stringId_, channel_, fretPos.fret, midiNote,
+                                       DEFAULT_VELOCITY, reportTimeUs_));
 
     // Update state
     noteOn_ = true;
@@ -134,8 +159,7 @@ void StringManager::sendNoteOff() {
         return; // Already off
     }
 
-    // Send MIDI Note Off
-    midiOut_.sendNoteOff(MIDI_CHANNEL, currentMidiNote_, 64);
+    bus_.publish(NoteEvent::noteOff(stringId_, channel_, currentMidiNote_, 64, reportTimeUs_));
 
     // Update state
     noteOn_ = false;
@@ -143,4 +167,18 @@ void StringManager::sendNoteOff() {
     currentFret_ = -1;
 }
 
+void StringManager::updatePitchBend(float frequencyHz) {
+    uint16_t bend = NoteMapping::frequencyToPitchBend(frequencyHz, currentMidiNote_,
+                                                      MPE_PITCH_BEND_RANGE);
+
+    // Detector jitter is not worth wire time
+    int delta = static_cast<int>(bend) - static_cast<int>(lastBend_);
+    if (delta < PITCH_BEND_DEADBAND && delta > -PITCH_BEND_DEADBAND) {
+        return;
+    }
+
+    lastBend_ = bend;
+    bus_.publish(NoteEvent::pitchBend(stringId_, channel_, bend, false, reportTimeUs_));
+}
+
 } // namespace BassMINT
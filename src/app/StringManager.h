@@ -2,41 +2,60 @@
 
 #include "core/Types.h"
 #include "core/MidiEvents.h"
-#include "core/SysExEncoder.h"
+#include "core/NoteEvent.h"
 #include "dsp/StringProcessor.h"
-#include "hal/MidiDinOut.h"
+#include "app/NoteEventBus.h"
 #include <cstdint>
 
 namespace BassMINT {
 
 /**
- * @brief Manages MIDI event generation for a single string
+ * @brief Manages note event generation for a single string
  *
  * Responsibilities:
  * - Track current note state (on/off, which fret)
  * - Detect note changes (fret changes, string attack/release)
- * - Generate MIDI Note On/Off events
- * - Generate BassMINT SysEx messages
+ * - Publish Note On/Off and fret events
+ * - Publish pitch bend (PerStringChannel mode)
  * - Handle note hysteresis/debouncing
  *
- * One instance per string, coordinated by App.
+ * Events go to the NoteEventBus; the sinks on the bus decide how they
+ * leave (DIN MIDI, USB-MIDI, ...). One instance per string, coordinated
+ * by App.
  */
 class StringManager {
 public:
     /**
      * @brief Constructor
      * @param stringId Which string this manager handles
-     * @param midiOut Reference to MIDI output driver
+     * @param bus Where this string's note events are published
      */
-    StringManager(StringId stringId, MidiDinOut& midiOut);
+    StringManager(StringId stringId, NoteBus& bus);
 
     /**
      * @brief Update state and generate MIDI events
+     * @param report Latest state/pitch snapshot for this string
+     *
+     * Call this whenever the string's DSP has produced new state; reports
+     * for other strings are ignored
+     */
+    void update(const StringReport& report);
+
+    /**
+     * @brief Update from a processor on the same core
      * @param processor String processor with latest pitch/state
+     */
+    void update(const StringProcessor& processor) { update(processor.getReport()); }
+
+    /**
+     * @brief Select the channel layout (default SingleChannel)
      *
-     * Call this every main loop iteration with updated processor state
+     * PerStringChannel: this string's notes go to its own MPE member
+     * channel, each note starts with the bend to the detected pitch and
+     * slides/vibrato follow as pitch bend. Sends Note Off first if a note
+     * is on.
      */
-    void update(const StringProcessor& processor);
+    void setOutputMode(MidiOutputMode mode);
 
     /**
      * @brief Force note off (emergency stop)
@@ -60,7 +79,14 @@ public:
 
 private:
     StringId stringId_;
-    MidiDinOut& midiOut_;
+    NoteBus& bus_;
+
+    // Output configuration
+    MidiOutputMode outputMode_;
+    uint8_t channel_;
+
+    // Timestamp of the report being handled (carried by the events)
+    uint32_t reportTimeUs_;
 
     // Current state
     bool noteOn_;
@@ -73,6 +99,10 @@ private:
     int pendingFret_;
     static constexpr int FRET_CHANGE_THRESHOLD = 3; // Frames before accepting fret change
 
+    // Last bend handed to the scheduler (PerStringChannel)
+    uint16_t lastBend_;
+    static constexpr uint16_t PITCH_BEND_DEADBAND = 5; // ~3 cents at ±48 semitones
+
     /**
      * @brief Handle string attack (idle -> active)
      */
@@ -89,14 +119,19 @@ private:
     void handleFretChange(const FretPosition& newFretPos);
 
     /**
-     * @brief Send MIDI Note On + SysEx
+     * @brief Publish Note On and the fret
      */
     void sendNoteOn(const FretPosition& fretPos);
 
     /**
-     * @brief Send MIDI Note Off
+     * @brief Publish Note Off
      */
     void sendNoteOff();
+
+    /**
+     * @brief Follow the pitch of the sounding note with pitch bend
+     */
+    void updatePitchBend(float frequencyHz);
 };
 
 } // namespace BassMINT
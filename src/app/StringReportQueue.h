@@ -0,0 +1,77 @@
+#pragma once
+
+#include "core/Types.h"
+#include "dsp/SpscRingBuffer.h"
+#include "dsp/StringProcessor.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief DSP -> MIDI handoff of StringReports (BASSMINT_DUAL_CORE)
+ *
+ * The DSP side calls processStrings() in a loop: every processor that
+ * consumed samples posts a full StringReport snapshot. The MIDI side
+ * pop()s them and feeds its StringManagers.
+ *
+ * - Lock-free SpscRingBuffer, one producer and one consumer context
+ * - A report dropped on a full queue is counted and superseded by the
+ *   string's next report, so the producer never blocks
+ *
+ * Hardware-free: on the device core1 drives it with Timer::getTimeMicros,
+ * the host test from a std::thread with its own clock.
+ */
+class StringReportQueue {
+public:
+    static constexpr size_t CAPACITY = 32;
+
+    /**
+     * @brief Time source stamped into each report (microseconds)
+     */
+    using Clock = uint32_t (*)();
+
+    /**
+     * @brief Run each processor once and post its report (producer)
+     * @param processors First of count processors
+     * @param count Number of processors
+     * @param now Time source for the report timestamps
+     * @return Reports posted
+     */
+    size_t processStrings(StringProcessor* processors, size_t count, Clock now) {
+        size_t posted = 0;
+        for (size_t i = 0; i < count; ++i) {
+            if (!processors[i].process()) {
+                continue;
+            }
+
+            if (reports_.push(processors[i].getReport(now()))) {
+                posted++;
+            } else {
+                dropped_.store(dropped_.load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+            }
+        }
+        return posted;
+    }
+
+    /**
+     * @brief Take the oldest report (consumer)
+     * @return false if none is waiting
+     */
+    bool pop(StringReport& report) { return reports_.pop(report); }
+
+    /**
+     * @brief Reports lost to a full queue
+     */
+    uint32_t getDropped() const { return dropped_.load(std::memory_order_relaxed); }
+
+private:
+    SpscRingBuffer<StringReport, CAPACITY> reports_;
+
+    // Written by the producer only
+    std::atomic<uint32_t> dropped_{0};
+};
+
+} // namespace BassMINT
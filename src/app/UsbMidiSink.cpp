@@ -0,0 +1,85 @@
+#include "app/UsbMidiSink.h"
+#include "core/MidiEvents.h"
+
+namespace BassMINT {
+
+UsbMidiSink::UsbMidiSink(UsbMidiOut& usbMidiOut)
+    : usbMidiOut_(usbMidiOut)
+    , hasMpeConfiguration_(false)
+    , sysExBundles_(false)
+    , fretSysEx_(true)
+{
+    fretPending_.fill(false);
+}
+
+void UsbMidiSink::consume(const NoteEvent* events, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        const NoteEvent& event = events[i];
+
+        switch (event.type) {
+            case NoteEvent::Type::NoteOn:
+                usbMidiOut_.sendNoteOn(event.channel, event.note, event.velocity);
+                break;
+
+            case NoteEvent::Type::NoteOff:
+                usbMidiOut_.sendNoteOff(event.channel, event.note, event.velocity);
+                break;
+
+            case NoteEvent::Type::PitchBend:
+                usbMidiOut_.sendPitchBend(event.channel, event.bend);
+                break;
+
+            case NoteEvent::Type::Fret: {
+                uint8_t index = static_cast<uint8_t>(event.string);
+                if (fretSysEx_ && index < NUM_STRINGS) {
+                    frets_[index] = SysExEncoder::FretSysExPayload(
+                        event.string, event.fret, event.note, event.velocity);
+                    fretPending_[index] = true;
+                }
+                break;
+            }
+
+            case NoteEvent::Type::MpeConfiguration:
+                mpeConfiguration_ = event;
+                hasMpeConfiguration_ = true;
+                sendMpeConfiguration(usbMidiOut_, event.channel, event.memberChannels);
+                break;
+        }
+    }
+}
+
+void UsbMidiSink::onConnected() {
+    // Packed ahead of this pass' events, sent with them by endBatch()
+    if (hasMpeConfiguration_) {
+        sendMpeConfiguration(usbMidiOut_, mpeConfiguration_.channel,
+                             mpeConfiguration_.memberChannels);
+    }
+}
+
+void UsbMidiSink::endBatch() {
+    std::array<SysExEncoder::FretSysExPayload, NUM_STRINGS> updates;
+    size_t count = 0;
+    for (size_t i = 0; i < NUM_STRINGS; ++i) {
+        if (fretPending_[i]) {
+            updates[count++] = frets_[i];
+            fretPending_[i] = false;
+        }
+    }
+
+    if (sysExBundles_) {
+        SysExEncoder::BundleMessage message;
+        size_t length = SysExEncoder::encodeBundle(updates.data(), count, message);
+        if (length > 0) {
+            usbMidiOut_.sendSysEx(message.data(), length);
+        }
+    } else {
+        for (size_t i = 0; i < count; ++i) {
+            auto message = SysExEncoder::encode(updates[i]);
+            usbMidiOut_.sendSysEx(message.data(), message.size());
+        }
+    }
+
+    usbMidiOut_.flush();
+}
+
+} // namespace BassMINT
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "core/Types.h"
+#include "core/SysExEncoder.h"
+#include "app/NoteEventSink.h"
+#include "hal/UsbMidiOut.h"
+#include <array>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief USB-MIDI output sink (BASSMINT_USB_MIDI builds)
+ *
+ * Subscribed to the NoteEventBus next to the DIN MidiScheduler, it sends
+ * the same events over USB: notes, bends and the MPE configuration in
+ * event order, then the fret SysEx of the batch, and ends every batch
+ * with one UsbMidiOut::flush().
+ * Every note event of a main loop pass so reaches the host in a single
+ * bulk transfer.
+ *
+ * No priority scheduling: a full-speed transfer carries a whole batch in
+ * far less than one DIN byte time. Several Fret events for one string in
+ * a batch are reduced to the latest.
+ *
+ * Main loop only, like UsbMidiOut.
+ */
+class UsbMidiSink : public NoteEventSink {
+public:
+    /**
+     * @brief Constructor
+     * @param usbMidiOut USB output; must outlive the sink
+     */
+    explicit UsbMidiSink(UsbMidiOut& usbMidiOut);
+
+    /**
+     * @brief Translate bus events into USB-MIDI packets (NoteEventSink)
+     */
+    void consume(const NoteEvent* events, size_t count) override;
+
+    /**
+     * @brief Add the batch's fret SysEx and send everything (NoteEventSink)
+     */
+    void endBatch() override;
+
+    /**
+     * @brief A host has just opened the MIDI interface
+     *
+     * Repeats the MPE configuration (if one was announced), which was
+     * dropped while no host was listening. Call before the pass' dispatch.
+     */
+    void onConnected();
+
+    /**
+     * @brief Send fret updates as one version 2 bundle (default: version 1)
+     */
+    void setSysExBundles(bool enabled) { sysExBundles_ = enabled; }
+
+    /**
+     * @brief Send Fret events as BassMINT SysEx (default on)
+     */
+    void setFretSysEx(bool enabled) { fretSysEx_ = enabled; }
+
+private:
+    UsbMidiOut& usbMidiOut_;
+    std::array<SysExEncoder::FretSysExPayload, NUM_STRINGS> frets_;
+    std::array<bool, NUM_STRINGS> fretPending_;
+
+    // Last MPE configuration, repeated to each newly connected host
+    NoteEvent mpeConfiguration_;
+    bool hasMpeConfiguration_;
+    bool sysExBundles_;
+    bool fretSysEx_;
+};
+
+} // namespace BassMINT
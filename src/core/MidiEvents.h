@@ -39,6 +39,33 @@ struct MidiNoteOff {
         : channel(ch), note(n), velocity(vel) {}
 };
 
+// MPE Configuration Message: RPN 6 on the zone's master channel
+constexpr uint8_t MIDI_CC_DATA_ENTRY_MSB = 6;
+constexpr uint8_t MIDI_CC_RPN_LSB = 100;
+constexpr uint8_t MIDI_CC_RPN_MSB = 101;
+constexpr uint8_t MIDI_RPN_MPE_CONFIGURATION = 6;
+constexpr uint8_t MIDI_RPN_NULL = 127;
+
+/**
+ * @brief Send an MPE Configuration Message (RPN 6) as Control Changes
+ * @param output Anything with sendControlChange(channel, controller, value)
+ *               (MidiDinOut, UsbMidiOut)
+ * @param masterChannel Zone master channel (0 = lower zone)
+ * @param memberChannels Member channels in the zone (0 disables it)
+ *
+ * Selects the RPN, sets the member count, then deselects the RPN so
+ * stray data entry cannot change it.
+ */
+template<typename Output>
+void sendMpeConfiguration(Output& output, uint8_t masterChannel, uint8_t memberChannels) {
+    output.sendControlChange(masterChannel, MIDI_CC_RPN_MSB, 0);
+    output.sendControlChange(masterChannel, MIDI_CC_RPN_LSB, MIDI_RPN_MPE_CONFIGURATION);
+    output.sendControlChange(masterChannel, MIDI_CC_DATA_ENTRY_MSB, memberChannels);
+
+    output.sendControlChange(masterChannel, MIDI_CC_RPN_MSB, MIDI_RPN_NULL);
+    output.sendControlChange(masterChannel, MIDI_CC_RPN_LSB, MIDI_RPN_NULL);
+}
+
 /**
  * @brief Helper to build MIDI events from fret positions
  */
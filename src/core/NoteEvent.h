@@ -0,0 +1,87 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief One musical event, independent of the transport it leaves on
+ *
+ * What StringManager decides (a note starts, stops, bends, or lands on a
+ * fret), published on the NoteEventBus, plus the MPE zone setup App
+ * announces before the first note. Each sink turns it into its own wire
+ * format: MIDI bytes for DIN, USB-MIDI packets, text for a trace.
+ */
+struct NoteEvent {
+    enum class Type : uint8_t {
+        NoteOn,
+        NoteOff,
+        PitchBend,        // 14-bit bend on the string's channel
+        Fret,             // String + fret of the note just started (BassMINT SysEx)
+        MpeConfiguration  // Zone layout on its master channel (MPE RPN 6)
+    };
+
+    Type type;
+    StringId string;
+    uint8_t channel;     // MIDI channel (0-15)
+    uint8_t note;        // NoteOn/NoteOff/Fret: MIDI note
+    uint8_t velocity;    // NoteOn/NoteOff/Fret
+    int8_t fret;         // Fret: 0-24
+    bool noteStart;      // PitchBend: sets the pitch of the following Note On
+    uint8_t memberChannels; // MpeConfiguration: member channels in the zone
+    uint16_t bend;       // PitchBend: 0-16383, PITCH_BEND_CENTER = none
+    uint32_t timestampUs; // When the DSP produced the report behind it
+
+    NoteEvent()
+        : type(Type::NoteOff), string(StringId::E), channel(0), note(0), velocity(0),
+          fret(0), noteStart(false), memberChannels(0), bend(PITCH_BEND_CENTER),
+          timestampUs(0) {}
+
+    static NoteEvent noteOn(StringId string, uint8_t channel, uint8_t note,
+                            uint8_t velocity, uint32_t timestampUs) {
+        NoteEvent event(Type::NoteOn, string, channel, timestampUs);
+        event.note = note;
+        event.velocity = velocity;
+        return event;
+    }
+
+    static NoteEvent noteOff(StringId string, uint8_t channel, uint8_t note,
+                             uint8_t velocity, uint32_t timestampUs) {
+        NoteEvent event(Type::NoteOff, string, channel, timestampUs);
+        event.note = note;
+        event.velocity = velocity;
+        return event;
+    }
+
+    static NoteEvent pitchBend(StringId string, uint8_t channel, uint16_t bend,
+                               bool noteStart, uint32_t timestampUs) {
+        NoteEvent event(Type::PitchBend, string, channel, timestampUs);
+        event.bend = bend;
+        event.noteStart = noteStart;
+        return event;
+    }
+
+    static NoteEvent fretChange(StringId string, uint8_t channel, int fret, uint8_t note,
+                                uint8_t velocity, uint32_t timestampUs) {
+        NoteEvent event(Type::Fret, string, channel, timestampUs);
+        event.fret = static_cast<int8_t>(fret);
+        event.note = note;
+        event.velocity = velocity;
+        return event;
+    }
+
+    static NoteEvent mpeConfiguration(uint8_t masterChannel, uint8_t memberChannels) {
+        NoteEvent event(Type::MpeConfiguration, StringId::E, masterChannel, 0);
+        event.memberChannels = memberChannels;
+        return event;
+    }
+
+private:
+    NoteEvent(Type t, StringId s, uint8_t ch, uint32_t time)
+        : type(t), string(s), channel(ch), note(0), velocity(0),
+          fret(0), noteStart(false), memberChannels(0), bend(PITCH_BEND_CENTER),
+          timestampUs(time) {}
+};
+
+} // namespace BassMINT
@@ -4,14 +4,6 @@
 
 namespace BassMINT {
 
-float NoteMapping::getOpenStringFrequency(StringId string) {
-    uint8_t index = static_cast<uint8_t>(string);
-    if (index >= NUM_STRINGS) {
-        return 0.0f;
-    }
-    return OPEN_STRING_FREQUENCIES[index];
-}
-
 int NoteMapping::frequencyToFret(StringId string, float frequencyHz) {
     if (frequencyHz <= 0.0f) {
         return -1;
@@ -71,6 +63,22 @@ uint8_t NoteMapping::frequencyToMidiNote(float frequencyHz) {
     return static_cast<uint8_t>(std::clamp(note, 0, 127));
 }
 
+uint16_t NoteMapping::frequencyToPitchBend(float frequencyHz, uint8_t midiNote,
+                                           uint8_t rangeSemitones) {
+    if (frequencyHz <= 0.0f || rangeSemitones == 0) {
+        return PITCH_BEND_CENTER;
+    }
+
+    // Deviation from the note in semitones, scaled to the bend range
+    float semitones = static_cast<float>(A4_MIDI_NOTE) - static_cast<float>(midiNote) +
+                      12.0f * std::log2(frequencyHz / A4_FREQUENCY);
+    float bend = static_cast<float>(PITCH_BEND_CENTER) +
+                 semitones * static_cast<float>(PITCH_BEND_CENTER) / rangeSemitones;
+
+    return static_cast<uint16_t>(
+        std::clamp(std::round(bend), 0.0f, static_cast<float>(PITCH_BEND_MAX)));
+}
+
 FretPosition NoteMapping::mapPitchToFret(StringId string, const PitchEstimate& pitch) {
     if (!pitch.isValid()) {
         return FretPosition(); // Invalid
@@ -17,12 +17,18 @@ namespace BassMINT {
  */
 class NoteMapping {
 public:
+    // Maximum fret number to consider
+    static constexpr int MAX_FRET = 24;
+
     /**
      * @brief Get open string frequency
      * @param string Which string
      * @return Frequency in Hz
      */
-    static float getOpenStringFrequency(StringId string);
+    static constexpr float getOpenStringFrequency(StringId string) {
+        uint8_t index = static_cast<uint8_t>(string);
+        return (index < NUM_STRINGS) ? OPEN_STRING_FREQUENCIES[index] : 0.0f;
+    }
 
     /**
      * @brief Convert frequency to fret number for a given string
@@ -47,6 +53,16 @@ public:
      */
     static uint8_t frequencyToMidiNote(float frequencyHz);
 
+    /**
+     * @brief Pitch bend that moves a MIDI note to a frequency
+     * @param frequencyHz Target frequency in Hz
+     * @param midiNote Note the bend applies to
+     * @param rangeSemitones Receiver's pitch bend range (±)
+     * @return 14-bit bend (PITCH_BEND_CENTER = none), clamped to the range
+     */
+    static uint16_t frequencyToPitchBend(float frequencyHz, uint8_t midiNote,
+                                         uint8_t rangeSemitones);
+
     /**
      * @brief Complete pitch-to-fret mapping
      * @param string Which string
@@ -91,9 +107,6 @@ private:
         43   // G2
     };
 
-    // Maximum fret number to consider
-    static constexpr int MAX_FRET = 24;
-
     // A4 reference (440 Hz = MIDI note 69)
     static constexpr float A4_FREQUENCY = 440.0f;
     static constexpr uint8_t A4_MIDI_NOTE = 69;
@@ -0,0 +1,86 @@
+#include "core/SysExDecoder.h"
+#include "core/NoteMapping.h"
+
+namespace BassMINT {
+
+bool SysExDecoder::decode(const uint8_t* data, size_t length, Frame& frame) {
+    frame.count = 0;
+
+    if (!data || length < SysExEncoder::HEADER_SIZE + 1) {
+        return false;
+    }
+
+    if (data[0] != SysExEncoder::SYSEX_START ||
+        data[1] != SysExEncoder::MANUFACTURER_ID ||
+        data[2] != SysExEncoder::BASSMINT_ID_1 ||
+        data[3] != SysExEncoder::BASSMINT_ID_2 ||
+        data[length - 1] != SysExEncoder::SYSEX_END) {
+        return false;
+    }
+
+    // SysEx data bytes are 7-bit
+    for (size_t i = 1; i < length - 1; ++i) {
+        if (data[i] & 0x80) {
+            return false;
+        }
+    }
+
+    frame.version = data[4];
+    switch (frame.version) {
+        case SysExEncoder::PROTOCOL_VERSION:
+            return decodeSingle(data, length, frame);
+        case SysExEncoder::PROTOCOL_VERSION_BUNDLE:
+            return decodeBundle(data, length, frame);
+        default:
+            return false;
+    }
+}
+
+bool SysExDecoder::decodeSingle(const uint8_t* data, size_t length, Frame& frame) {
+    if (length != 10 || data[5] >= NUM_STRINGS) {
+        return false;
+    }
+
+    frame.updates[0] = SysExEncoder::FretSysExPayload(
+        static_cast<StringId>(data[5]), data[6], data[7], data[8]);
+    frame.count = 1;
+    return true;
+}
+
+bool SysExDecoder::decodeBundle(const uint8_t* data, size_t length, Frame& frame) {
+    size_t pos = SysExEncoder::HEADER_SIZE;
+    uint8_t stringMask = data[pos++];
+
+    if (stringMask == 0 || (stringMask >> NUM_STRINGS) != 0) {
+        return false;
+    }
+
+    size_t strings = 0;
+    for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
+        strings += (stringMask >> i) & 1u;
+    }
+    if (length != SysExEncoder::HEADER_SIZE + 2 + 2 * strings) {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
+        if (!(stringMask & (1u << i))) {
+            continue;
+        }
+
+        StringId string = static_cast<StringId>(i);
+        int fret = data[pos++];
+        uint8_t velocity = data[pos++];
+        if (fret > NoteMapping::MAX_FRET) {
+            frame.count = 0;
+            return false;
+        }
+
+        frame.updates[frame.count++] = SysExEncoder::FretSysExPayload(
+            string, fret, NoteMapping::fretToMidiNote(string, fret), velocity);
+    }
+
+    return true;
+}
+
+} // namespace BassMINT
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "core/Types.h"
+#include "core/SysExEncoder.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Decoder for BassMINT SysEx messages (versions 1 and 2)
+ *
+ * Reference for receivers (DAW plugins, test tools): the firmware itself
+ * only encodes. No allocation and no hardware access, so it builds for the
+ * host as is (with NoteMapping for the v2 MIDI note).
+ *
+ * Accepts one complete message, F0 through F7. Anything malformed (wrong
+ * ID, 8-bit data, length not matching the string mask, unknown string or
+ * version) is rejected as a whole.
+ */
+class SysExDecoder {
+public:
+    /**
+     * @brief Fret updates carried by one message
+     */
+    struct Frame {
+        uint8_t version = 0;  // 1 (one string) or 2 (bundle)
+        uint8_t count = 0;    // Valid entries in updates, ascending string order
+        std::array<SysExEncoder::FretSysExPayload, NUM_STRINGS> updates;
+    };
+
+    /**
+     * @brief Decode a BassMINT SysEx message
+     * @param data Message bytes (F0 ... F7)
+     * @param length Number of bytes
+     * @param frame Output; unspecified if decoding fails
+     * @return true if the message was a valid BassMINT fret message
+     */
+    static bool decode(const uint8_t* data, size_t length, Frame& frame);
+
+private:
+    static bool decodeSingle(const uint8_t* data, size_t length, Frame& frame);
+    static bool decodeBundle(const uint8_t* data, size_t length, Frame& frame);
+};
+
+} // namespace BassMINT
@@ -27,6 +27,48 @@ std::array<uint8_t, 10> SysExEncoder::encode(const FretSysExPayload& payload) {
     return message;
 }
 
+size_t SysExEncoder::encodeBundle(const FretSysExPayload* updates, size_t count,
+                                  BundleMessage& message) {
+    // Latest update per string
+    std::array<const FretSysExPayload*, NUM_STRINGS> byString = {};
+    for (size_t i = 0; updates && i < count; ++i) {
+        uint8_t index = static_cast<uint8_t>(updates[i].string);
+        if (index < NUM_STRINGS) {
+            byString[index] = &updates[i];
+        }
+    }
+
+    uint8_t stringMask = 0;
+    for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
+        if (byString[i]) {
+            stringMask |= static_cast<uint8_t>(1u << i);
+        }
+    }
+    if (stringMask == 0) {
+        return 0;
+    }
+
+    size_t length = 0;
+    message[length++] = SYSEX_START;
+    message[length++] = MANUFACTURER_ID;
+    message[length++] = BASSMINT_ID_1;
+    message[length++] = BASSMINT_ID_2;
+    message[length++] = PROTOCOL_VERSION_BUNDLE;
+    message[length++] = stringMask;
+
+    for (const FretSysExPayload* update : byString) {
+        if (!update) {
+            continue;
+        }
+        message[length++] = static_cast<uint8_t>(
+            std::clamp(update->fret, 0, NoteMapping::MAX_FRET));
+        message[length++] = update->velocity & 0x7F;
+    }
+
+    message[length++] = SYSEX_END;
+    return length;
+}
+
 SysExEncoder::FretSysExPayload
 SysExEncoder::fromFretPosition(const FretPosition& fretPos, uint8_t velocity) {
     uint8_t midiNote = NoteMapping::fretToMidiNote(fretPos.string, fretPos.fret);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "core/Types.h"
+#include <cstddef>
 #include <cstdint>
 #include <array>
 
@@ -22,6 +23,17 @@ namespace BassMINT {
  *
  * Total: 10 bytes
  *
+ * Version 2 bundles every string that changed in one tick into one frame:
+ *   F0 7D 'B' 'M'        - as above
+ *   0x02                 - Protocol version
+ *   stringMask           - Bit n set: string n follows (ascending order)
+ *   fret velocity        - Per string in the mask
+ *   F7                   - SysEx end
+ *
+ * Total: 7 + 2 bytes per string (15 for a four-string chord instead of
+ * 4 × 10). The MIDI note is left out: receivers derive it from string and
+ * fret (NoteMapping), as SysExDecoder does.
+ *
  * This allows DAW plugins to know exactly which string and fret was played,
  * enabling realistic bass guitar emulation beyond just MIDI notes.
  */
@@ -50,6 +62,23 @@ public:
      */
     static std::array<uint8_t, 10> encode(const FretSysExPayload& payload);
 
+    /**
+     * @brief Largest version 2 bundle (all strings)
+     */
+    static constexpr size_t BUNDLE_MAX_SIZE = 7 + 2 * NUM_STRINGS;
+
+    using BundleMessage = std::array<uint8_t, BUNDLE_MAX_SIZE>;
+
+    /**
+     * @brief Encode fret updates for several strings into one version 2 SysEx
+     * @param updates Fret updates (a later one for the same string wins)
+     * @param count Number of updates
+     * @param message Output buffer
+     * @return Message length in bytes, 0 if there was nothing to encode
+     */
+    static size_t encodeBundle(const FretSysExPayload* updates, size_t count,
+                               BundleMessage& message);
+
     /**
      * @brief Create payload from fret position
      * @param fretPos Fret position from pitch detection
@@ -59,14 +88,15 @@ public:
     static FretSysExPayload fromFretPosition(const FretPosition& fretPos,
                                              uint8_t velocity = DEFAULT_VELOCITY);
 
-private:
-    // SysEx constants
+    // SysEx constants (shared with SysExDecoder)
     static constexpr uint8_t SYSEX_START = 0xF0;
     static constexpr uint8_t SYSEX_END = 0xF7;
     static constexpr uint8_t MANUFACTURER_ID = 0x7D; // Non-commercial
     static constexpr uint8_t BASSMINT_ID_1 = 'B';
     static constexpr uint8_t BASSMINT_ID_2 = 'M';
     static constexpr uint8_t PROTOCOL_VERSION = 0x01;
+    static constexpr uint8_t PROTOCOL_VERSION_BUNDLE = 0x02;
+    static constexpr size_t HEADER_SIZE = 5; // F0 7D 'B' 'M' version
 };
 
 } // namespace BassMINT
@@ -59,7 +59,42 @@ enum class StringState : uint8_t {
 };
 
 /**
- * @brief Sample rate configuration
+ * @brief Snapshot of one string's DSP output
+ *
+ * What StringManager needs to make note decisions, detached from the
+ * StringProcessor so it can cross from the DSP core to the MIDI core by
+ * value (BASSMINT_DUAL_CORE).
+ */
+struct StringReport {
+    StringId string;
+    StringState state;
+    PitchEstimate pitch;
+    float envelope;        // Envelope level (debug stats)
+    uint32_t timestampUs;  // When the DSP produced it (latency stats)
+
+    StringReport()
+        : string(StringId::E), state(StringState::Idle), envelope(0.0f), timestampUs(0) {}
+
+    bool isActive() const {
+        return state == StringState::Active || state == StringState::Attack;
+    }
+};
+
+/**
+ * @brief ADC aggregate conversion rate (all strings together)
+ *
+ * The single RP2040 ADC is shared round-robin by the NUM_STRINGS inputs,
+ * so this is the rate the ADC (or the timer, in timer mode) must
+ * actually run at. 32 ksps is well under the ADC's 500 ksps limit.
+ */
+constexpr uint32_t ADC_AGGREGATE_RATE_HZ = 32000;
+
+/**
+ * @brief Per-string sample rate (derived, never set directly)
+ *
+ * Every DSP block (StringProcessor, EnvelopeFollower, pitch detectors,
+ * AnalysisGeometry) takes this as its rate; the HAL derives its pacing
+ * from ADC_AGGREGATE_RATE_HZ, so the two cannot drift apart.
  *
  * 8kHz chosen as reasonable tradeoff:
  * - Nyquist = 4kHz, well above highest bass fundamental (~400Hz for G string high frets)
@@ -67,7 +102,10 @@ enum class StringState : uint8_t {
  * - Lower CPU/memory than 16kHz or 44.1kHz
  * - RP2040 has plenty of headroom for 4 channels @ 8kHz
  */
-constexpr uint32_t SAMPLE_RATE_HZ = 8000;
+constexpr uint32_t SAMPLE_RATE_HZ = ADC_AGGREGATE_RATE_HZ / NUM_STRINGS;
+
+static_assert(ADC_AGGREGATE_RATE_HZ % NUM_STRINGS == 0,
+              "Aggregate ADC rate must split evenly across the strings");
 
 /**
  * @brief Frame size for pitch detection
@@ -80,14 +118,29 @@ constexpr uint32_t SAMPLE_RATE_HZ = 8000;
  */
 constexpr uint32_t PITCH_FRAME_SIZE = 1024;
 
+/**
+ * @brief Hop size between pitch estimates (sliding analysis window)
+ *
+ * 128 samples @ 8kHz = 16ms between pitch updates
+ * - YIN always sees the latest PITCH_FRAME_SIZE samples
+ * - 8x more updates than non-overlapping 1024-sample frames
+ * - See option 3 in docs/YIN_BASS_ANALYSIS.md
+ */
+constexpr uint32_t PITCH_HOP_SIZE = 128;
+
 /**
  * @brief Ring buffer size per string (must be power of 2)
  *
  * 1024 samples @ 8kHz = 128ms buffering
- * Allows for ~2 full pitch frames in buffer
+ * Only decouples the ADC ISR from the main loop; the analysis window
+ * lives in StringProcessor, so this just needs to exceed one hop plus
+ * worst-case main loop stalls.
  */
 constexpr uint32_t RING_BUFFER_SIZE = 1024;
 
+static_assert(PITCH_HOP_SIZE <= PITCH_FRAME_SIZE, "Hop must not exceed the analysis window");
+static_assert(PITCH_HOP_SIZE < RING_BUFFER_SIZE, "Ring buffer must hold at least one hop");
+
 // Confidence threshold for accepting pitch detection
 constexpr float MIN_PITCH_CONFIDENCE = 0.7f;
 
@@ -95,4 +148,20 @@ constexpr float MIN_PITCH_CONFIDENCE = 0.7f;
 constexpr uint8_t MIDI_CHANNEL = 0;  // MIDI channel 1 (0-indexed)
 constexpr uint8_t DEFAULT_VELOCITY = 100;
 
+/**
+ * @brief How strings map onto MIDI channels
+ */
+enum class MidiOutputMode : uint8_t {
+    SingleChannel,    // Every string on MIDI_CHANNEL; string + fret via SysEx
+    PerStringChannel  // MPE lower zone: one member channel per string, pitch bend
+};
+
+// MPE lower zone (PerStringChannel): master channel 1, string n on channel 2 + n
+constexpr uint8_t MPE_MASTER_CHANNEL = 0;
+constexpr uint8_t MPE_FIRST_MEMBER_CHANNEL = 1;
+constexpr uint8_t MPE_PITCH_BEND_RANGE = 48;  // Semitones, MPE member channel default
+
+constexpr uint16_t PITCH_BEND_CENTER = 8192;  // 14-bit, no bend
+constexpr uint16_t PITCH_BEND_MAX = 16383;
+
 } // namespace BassMINT
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "core/Types.h"
+#include "core/NoteMapping.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Per-string pitch analysis geometry (lag bounds + window length)
+ *
+ * Derived from the string's open frequency and NoteMapping::MAX_FRET
+ * instead of one 30-400 Hz range for every string (option 2 in
+ * docs/YIN_BASS_ANALYSIS.md):
+ * - Frequency range: open string to fret MAX_FRET, widened by
+ *   MARGIN_SEMITONES on each side (matches isFrequencyPlausible)
+ * - Lag range: sampleRate / maxFreq .. sampleRate / minFreq
+ * - Window: MIN_WINDOW_PERIODS (YIN; detectors may ask for fewer) of the
+ *   longest period, rounded up to WINDOW_GRANULARITY and capped at
+ *   PITCH_FRAME_SIZE
+ *
+ * @ 8 kHz: E 896 / A 704 / D 512 / G 384 samples, so the upper strings get
+ * both a shorter latency and far fewer lags per frame.
+ *
+ * Everything is constexpr so the result can size arrays at compile time.
+ */
+struct AnalysisGeometry {
+    static constexpr int MARGIN_SEMITONES = 2;
+    static constexpr size_t MIN_WINDOW_PERIODS = 4;
+    static constexpr size_t WINDOW_GRANULARITY = 64;
+
+    float minFreq;      // Lowest detectable frequency (Hz)
+    float maxFreq;      // Highest detectable frequency (Hz)
+    size_t minLag;      // sampleRate / maxFreq
+    size_t maxLag;      // sampleRate / minFreq (<= windowSize / 2)
+    size_t windowSize;  // Analysis window length in samples
+
+    /**
+     * @brief Geometry for one string
+     * @param string Which string
+     * @param sampleRate Per-string sample rate in Hz
+     * @param windowPeriods Periods of the lowest note the window must hold
+     */
+    static constexpr AnalysisGeometry forString(StringId string,
+                                                float sampleRate = SAMPLE_RATE_HZ,
+                                                size_t windowPeriods = MIN_WINDOW_PERIODS) {
+        float openFreq = NoteMapping::getOpenStringFrequency(string);
+
+        AnalysisGeometry g{};
+        g.minFreq = openFreq * semitoneRatio(-MARGIN_SEMITONES);
+        g.maxFreq = openFreq * semitoneRatio(NoteMapping::MAX_FRET + MARGIN_SEMITONES);
+
+        // Same truncation as PitchDetectorYin's constructor
+        g.minLag = static_cast<size_t>(sampleRate / g.maxFreq);
+        g.maxLag = static_cast<size_t>(sampleRate / g.minFreq);
+
+        size_t window = windowPeriods * (g.maxLag + 1);
+        window = ((window + WINDOW_GRANULARITY - 1) / WINDOW_GRANULARITY) * WINDOW_GRANULARITY;
+        g.windowSize = (window < PITCH_FRAME_SIZE) ? window : PITCH_FRAME_SIZE;
+
+        // YIN needs the lag to stay within half the window
+        if (g.maxLag > g.windowSize / 2) {
+            g.maxLag = g.windowSize / 2;
+        }
+        if (g.minLag < 1) {
+            g.minLag = 1;
+        }
+
+        return g;
+    }
+
+    /**
+     * @brief Equal-temperament frequency ratio for a semitone offset
+     */
+    static constexpr float semitoneRatio(int semitones) {
+        constexpr double SEMITONE = 1.0594630943592953; // 2^(1/12)
+        double ratio = 1.0;
+        for (int i = 0; i < semitones; ++i) {
+            ratio *= SEMITONE;
+        }
+        for (int i = 0; i > semitones; --i) {
+            ratio /= SEMITONE;
+        }
+        return static_cast<float>(ratio);
+    }
+};
+
+} // namespace BassMINT
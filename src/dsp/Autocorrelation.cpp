@@ -0,0 +1,37 @@
+#include "dsp/Autocorrelation.h"
+#include "dsp/RealFft.h"
+#include <array>
+#include <cstring>
+
+namespace BassMINT {
+
+static constexpr size_t FFT_SIZE = 2 * PITCH_FRAME_SIZE;
+
+static RealFft<FFT_SIZE> g_fft;
+static std::array<float, FFT_SIZE> g_fftBuffer;
+
+const float* Autocorrelation::compute(const float* samples, size_t count) {
+    float* buffer = g_fftBuffer.data();
+
+    // Zero-padded copy of the frame
+    std::memcpy(buffer, samples, count * sizeof(float));
+    std::memset(buffer + count, 0, (FFT_SIZE - count) * sizeof(float));
+
+    // Autocorrelation = IFFT(|FFT(x)|^2)
+    g_fft.forward(buffer);
+
+    buffer[0] *= buffer[0]; // DC
+    buffer[1] *= buffer[1]; // Nyquist
+    for (size_t k = 2; k < FFT_SIZE; k += 2) {
+        float re = buffer[k];
+        float im = buffer[k + 1];
+        buffer[k] = re * re + im * im;
+        buffer[k + 1] = 0.0f;
+    }
+
+    g_fft.inverse(buffer);
+
+    return buffer;
+}
+
+} // namespace BassMINT
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief FFT autocorrelation shared by the pitch detectors
+ *
+ * acf(tau) = sum(x[j] * x[j+tau]), j = 0 .. N-1-tau, computed as
+ * IFFT(|FFT(x)|^2) on a frame zero-padded to 2 * PITCH_FRAME_SIZE, which
+ * keeps the circular correlation free of wrap-around for every lag.
+ *
+ * One static FFT and workspace (8 KB + 2 KB twiddles) serve every
+ * detector: estimate() only ever runs from the main loop, one string at
+ * a time.
+ */
+class Autocorrelation {
+public:
+    /**
+     * @brief Compute the autocorrelation of a frame
+     * @param samples Input frame
+     * @param count Frame length (<= PITCH_FRAME_SIZE)
+     * @return acf(tau) for tau = 0 .. count-1, valid until the next call
+     */
+    static const float* compute(const float* samples, size_t count);
+};
+
+} // namespace BassMINT
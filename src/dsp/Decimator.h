@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief Block FIR low-pass decimator
+ *
+ * Windowed-sinc (Hamming) low-pass followed by keeping every factor-th
+ * output, computed only at the kept positions. Works on whole frames:
+ * output[k] = sum(h[i] * input[k * factor + i]), so no state carries over
+ * between calls and nothing is allocated.
+ *
+ * Output length for an N-sample block: (N - Taps) / factor + 1.
+ *
+ * @tparam Taps Filter length (odd keeps the group delay an integer)
+ */
+template<size_t Taps>
+class Decimator {
+public:
+    static_assert(Taps % 2 == 1, "Taps must be odd");
+
+    /**
+     * @brief Constructor
+     * @param factor Decimation factor (>= 1)
+     * @param cutoff Pass-band edge as a fraction of the output Nyquist
+     */
+    explicit Decimator(size_t factor, float cutoff = 0.8f)
+        : factor_(factor < 1 ? 1 : factor)
+    {
+        constexpr float PI = 3.14159265358979f;
+        constexpr float CENTER = static_cast<float>(Taps - 1) / 2.0f;
+
+        // Normalized cutoff in cycles/sample at the input rate
+        float fc = cutoff * 0.5f / static_cast<float>(factor_);
+
+        float sum = 0.0f;
+        for (size_t i = 0; i < Taps; ++i) {
+            float n = static_cast<float>(i) - CENTER;
+            float sinc = (n == 0.0f) ? 2.0f * fc : std::sin(2.0f * PI * fc * n) / (PI * n);
+            float window = 0.54f - 0.46f * std::cos(2.0f * PI * static_cast<float>(i)
+                                                    / static_cast<float>(Taps - 1));
+            coefficients_[i] = sinc * window;
+            sum += coefficients_[i];
+        }
+
+        // Unity gain at DC
+        for (float& c : coefficients_) {
+            c /= sum;
+        }
+    }
+
+    /**
+     * @brief Output length for an input block
+     */
+    size_t getOutputSize(size_t inputCount) const {
+        return (inputCount < Taps) ? 0 : (inputCount - Taps) / factor_ + 1;
+    }
+
+    /**
+     * @brief Filter and decimate one block
+     * @param input Input samples
+     * @param inputCount Number of input samples
+     * @param output Destination, getOutputSize(inputCount) entries
+     * @return Number of samples written
+     */
+    size_t process(const float* input, size_t inputCount, float* output) const {
+        size_t outputCount = getOutputSize(inputCount);
+
+        for (size_t k = 0; k < outputCount; ++k) {
+            const float* x = input + k * factor_;
+            float acc = 0.0f;
+            for (size_t i = 0; i < Taps; ++i) {
+                acc += coefficients_[i] * x[i];
+            }
+            output[k] = acc;
+        }
+
+        return outputCount;
+    }
+
+    /**
+     * @brief Get decimation factor
+     */
+    size_t getFactor() const { return factor_; }
+
+private:
+    size_t factor_;
+    std::array<float, Taps> coefficients_;
+};
+
+} // namespace BassMINT
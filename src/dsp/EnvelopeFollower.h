@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Types.h"
 #include <cstdint>
 #include <cmath>
 
@@ -23,7 +24,7 @@ public:
      * @param attackTimeMs Attack time constant in milliseconds
      * @param releaseTimeMs Release time constant in milliseconds
      */
-    EnvelopeFollower(float sampleRate = 8000.0f,
+    EnvelopeFollower(float sampleRate = SAMPLE_RATE_HZ,
                      float attackTimeMs = 10.0f,
                      float releaseTimeMs = 100.0f);
 
@@ -0,0 +1,58 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Which pitch detection algorithm a string uses
+ */
+enum class PitchDetectorType : uint8_t {
+    Yin, // PitchDetectorYin (CMNDF, first dip below threshold)
+    Mpm  // PitchDetectorMpm (NSDF, first key maximum above cutoff)
+};
+
+/**
+ * @brief Common interface of the float pitch detectors
+ *
+ * StringProcessor talks to its detector only through this, so the
+ * algorithm can be chosen per string (PitchDetectorType).
+ */
+class PitchDetector {
+public:
+    virtual ~PitchDetector() = default;
+
+    /**
+     * @brief Estimate pitch from a window that slid forward by 'hop' samples
+     * @param samples Input audio samples (length = bufferSize)
+     * @param count Number of samples (must equal bufferSize)
+     * @param hop Samples the window advanced since the previous call
+     *            (0 = unrelated window)
+     * @return Pitch estimate with frequency and confidence
+     */
+    virtual PitchEstimate estimate(const float* samples, size_t count, size_t hop) = 0;
+
+    /**
+     * @brief Forget history carried between windows
+     */
+    virtual void reset() {}
+
+    /**
+     * @brief A new note started (re-attack): drop any pitch hint
+     */
+    virtual void clearTrackingHint() {}
+
+    /**
+     * @brief Set confidence threshold for valid pitch
+     */
+    virtual void setConfidenceThreshold(float threshold) = 0;
+
+    /**
+     * @brief Get current confidence threshold
+     */
+    virtual float getConfidenceThreshold() const = 0;
+};
+
+} // namespace BassMINT
@@ -0,0 +1,125 @@
+#include "dsp/PitchDetectorMpm.h"
+#include "dsp/Autocorrelation.h"
+#include "dsp/ScratchArena.h"
+#include "dsp/YinKernel.h"
+#include <algorithm>
+#include <array>
+
+namespace BassMINT {
+
+// Key maxima remembered per frame (one per positive NSDF lobe)
+static constexpr size_t MAX_KEY_MAXIMA = 32;
+
+PitchDetectorMpm::PitchDetectorMpm(float sampleRate, size_t bufferSize,
+                                   float minFreq, float maxFreq)
+    : sampleRate_(sampleRate)
+    , bufferSize_(std::min(bufferSize, static_cast<size_t>(PITCH_FRAME_SIZE)))
+    , confidenceThreshold_(0.5f) // Lobes below this are not key maxima candidates
+    , nsdf_(nullptr)
+{
+    // Calculate lag bounds from frequency range
+    maxLag_ = static_cast<size_t>(sampleRate_ / minFreq);
+    minLag_ = static_cast<size_t>(sampleRate_ / maxFreq);
+
+    // Clamp to buffer size and MAX_LAG
+    maxLag_ = std::min(maxLag_, bufferSize_ / 2);
+    maxLag_ = std::min(maxLag_, MAX_LAG - 1);
+    minLag_ = std::max(minLag_, size_t(1));
+}
+
+PitchEstimate PitchDetectorMpm::estimate(const float* samples, size_t count) {
+    if (!samples || count != bufferSize_) {
+        return PitchEstimate(); // Invalid input
+    }
+
+    ScratchArena::Lease scratch(ScratchArena::Region::Detector, this);
+    nsdf_ = scratch.get<float>();
+
+    computeNsdf(samples);
+
+    size_t tau = pickPeak();
+
+    if (tau == 0) {
+        return PitchEstimate(); // No pitch detected
+    }
+
+    // Parabolic interpolation (vertex formula is the same for a maximum)
+    float refinedTau = YinKernel::parabolicInterpolation(nsdf_, tau, maxLag_);
+
+    return PitchEstimate(sampleRate_ / refinedTau, nsdf_[tau]);
+}
+
+PitchEstimate PitchDetectorMpm::estimate(const float* samples, size_t count, size_t hop) {
+    (void)hop;
+    return estimate(samples, count);
+}
+
+void PitchDetectorMpm::computeNsdf(const float* samples) {
+    const float* acf = Autocorrelation::compute(samples, bufferSize_);
+
+    // nsdf(tau) = 2 * acf(tau) / (e_head(tau) + e_tail(tau))
+    float energy = YinKernel::energy(samples, bufferSize_);
+    float headEnergy = energy;
+    float tailEnergy = energy;
+
+    for (size_t tau = 0; tau < maxLag_; ++tau) {
+        float energySum = headEnergy + tailEnergy;
+        nsdf_[tau] = (energySum > 0.0f) ? 2.0f * acf[tau] / energySum : 0.0f;
+
+        float leavingHead = samples[bufferSize_ - 1 - tau];
+        float leavingTail = samples[tau];
+        headEnergy -= leavingHead * leavingHead;
+        tailEnergy -= leavingTail * leavingTail;
+    }
+}
+
+size_t PitchDetectorMpm::pickPeak() const {
+    std::array<size_t, MAX_KEY_MAXIMA> keyMaxima;
+    size_t numKeyMaxima = 0;
+    float highest = 0.0f;
+
+    // Skip the lobe around lag 0
+    size_t tau = 1;
+    while (tau < maxLag_ && nsdf_[tau] > 0.0f) {
+        tau++;
+    }
+
+    // One key maximum per positive lobe
+    while (tau < maxLag_ && numKeyMaxima < MAX_KEY_MAXIMA) {
+        // Next positive-going zero crossing
+        while (tau < maxLag_ && nsdf_[tau] <= 0.0f) {
+            tau++;
+        }
+
+        size_t peak = 0;
+        while (tau < maxLag_ && nsdf_[tau] > 0.0f) {
+            if (peak == 0 || nsdf_[tau] > nsdf_[peak]) {
+                peak = tau;
+            }
+            tau++;
+        }
+
+        // A lobe cut off by maxLag only counts if it already turned down
+        bool complete = tau < maxLag_ || (peak != 0 && peak + 1 < maxLag_);
+        if (peak >= minLag_ && complete) {
+            keyMaxima[numKeyMaxima++] = peak;
+            highest = std::max(highest, nsdf_[peak]);
+        }
+    }
+
+    if (highest < confidenceThreshold_) {
+        return 0; // No valid pitch
+    }
+
+    // First key maximum close enough to the highest one
+    float cutoff = MPM_CUTOFF * highest;
+    for (size_t i = 0; i < numKeyMaxima; ++i) {
+        if (nsdf_[keyMaxima[i]] >= cutoff) {
+            return keyMaxima[i];
+        }
+    }
+
+    return 0;
+}
+
+} // namespace BassMINT
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Types.h"
+#include "dsp/PitchDetector.h"
+#include "dsp/ScratchArena.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief McLeod Pitch Method (McLeod & Wyvill, 2005)
+ *
+ * Normalized square difference function:
+ *   nsdf(tau) = 2 * acf(tau) / (e_head(tau) + e_tail(tau))   in [-1, 1]
+ * (= 1 - d(tau) / (e_head + e_tail) in YIN terms). The autocorrelation
+ * comes from the shared FFT (Autocorrelation), the energy terms are
+ * walked down lag by lag.
+ *
+ * Peak picking: every positive lobe between a positive- and the next
+ * negative-going zero crossing contributes one key maximum; the first key
+ * maximum >= MPM_CUTOFF * (highest key maximum) is the period. The NSDF
+ * normalization keeps long lags usable, so MPM copes with windows of
+ * about MPM_WINDOW_PERIODS periods where YIN wants four.
+ *
+ * Confidence is the clarity (NSDF value at the peak); the threshold is
+ * the minimum clarity for a valid estimate.
+ */
+class PitchDetectorMpm : public PitchDetector {
+public:
+    /**
+     * @brief Fraction of the highest key maximum the chosen peak must reach
+     */
+    static constexpr float MPM_CUTOFF = 0.9f;
+
+    /**
+     * @brief Periods of the lowest note a window needs (see AnalysisGeometry)
+     */
+    static constexpr size_t MPM_WINDOW_PERIODS = 3;
+
+    /**
+     * @brief Constructor
+     * @param sampleRate Sample rate in Hz (e.g., 8000)
+     * @param bufferSize Analysis window size in samples (<= PITCH_FRAME_SIZE)
+     * @param minFreq Minimum detectable frequency in Hz (e.g., 30)
+     * @param maxFreq Maximum detectable frequency in Hz (e.g., 400)
+     */
+    PitchDetectorMpm(float sampleRate = SAMPLE_RATE_HZ,
+                     size_t bufferSize = PITCH_FRAME_SIZE,
+                     float minFreq = 30.0f,
+                     float maxFreq = 400.0f);
+
+    /**
+     * @brief Estimate pitch from audio buffer
+     * @param samples Input audio samples (length = bufferSize)
+     * @param count Number of samples (must equal bufferSize)
+     * @return Pitch estimate with frequency and clarity as confidence
+     */
+    PitchEstimate estimate(const float* samples, size_t count);
+
+    /**
+     * @brief Estimate pitch (MPM keeps no history, 'hop' is ignored)
+     */
+    PitchEstimate estimate(const float* samples, size_t count, size_t hop) override;
+
+    /**
+     * @brief Set minimum clarity for a valid pitch
+     * @param threshold Minimum NSDF peak (0.0-1.0)
+     */
+    void setConfidenceThreshold(float threshold) override {
+        confidenceThreshold_ = threshold;
+    }
+
+    /**
+     * @brief Get minimum clarity for a valid pitch
+     */
+    float getConfidenceThreshold() const override {
+        return confidenceThreshold_;
+    }
+
+private:
+    float sampleRate_;
+    size_t bufferSize_;
+    float confidenceThreshold_;
+
+    // Pre-calculated lag bounds
+    size_t minLag_;
+    size_t maxLag_;
+
+    // Working buffer, borrowed from the ScratchArena Detector region for
+    // the duration of estimate()
+    static constexpr size_t MAX_LAG = PITCH_FRAME_SIZE / 2 + 1;
+    float* nsdf_;
+
+    static_assert(MAX_LAG * sizeof(float) <= ScratchArena::DETECTOR_BYTES,
+                  "NSDF exceeds the scratch region");
+
+    /**
+     * @brief Compute nsdf_[0 .. maxLag_)
+     * @param samples Input samples
+     */
+    void computeNsdf(const float* samples);
+
+    /**
+     * @brief Pick the period among the NSDF key maxima
+     * @return Lag of the chosen peak, or 0 if none found
+     */
+    size_t pickPeak() const;
+};
+
+} // namespace BassMINT
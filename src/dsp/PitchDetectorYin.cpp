@@ -1,17 +1,66 @@
 #include "dsp/PitchDetectorYin.h"
+#include "dsp/Autocorrelation.h"
+#include "dsp/ScratchArena.h"
+#include "dsp/YinKernel.h"
 #include <cmath>
 #include <algorithm>
 #include <cstring>
 
 namespace BassMINT {
 
+// Tracking window edges relative to the tracked lag
+static constexpr float TRACKING_RATIO =
+    AnalysisGeometry::semitoneRatio(PitchDetectorYin::TRACKING_SEMITONES);
+
+// Tracking also probes tracked lag / 2 .. / TRACKING_MAX_DIVISOR for a
+// shorter period (octave, fifth up)
+static constexpr uint32_t TRACKING_MAX_DIVISOR = 3;
+
+// Specialized YIN loops for one frame size / lag range
+struct YinSpecialization {
+    size_t frameSize;
+    size_t minLag;
+    size_t maxLag;
+    void (*difference)(const float* samples, float* difference);
+    void (*cmndf)(const float* difference, float* cmndf);
+    size_t (*absoluteThreshold)(const float* cmndf, float threshold);
+    size_t (*fusedSearch)(const float* samples, float* difference, float* cmndf,
+                          float threshold);
+};
+
+template<StringId S>
+static constexpr YinSpecialization specializedFor() {
+    using Kernel = typename StringPitchDetectorYin<S>::Kernel;
+    return {Kernel::FRAME_SIZE, Kernel::MIN_LAG, Kernel::MAX_LAG,
+            &Kernel::difference, &Kernel::cmndf, &Kernel::absoluteThreshold,
+            &Kernel::fusedSearch};
+}
+
+// One instantiation per string geometry (what StringProcessor constructs)
+static constexpr YinSpecialization g_specializedKernels[] = {
+    specializedFor<StringId::E>(),
+    specializedFor<StringId::A>(),
+    specializedFor<StringId::D>(),
+    specializedFor<StringId::G>(),
+};
+
 PitchDetectorYin::PitchDetectorYin(float sampleRate, size_t bufferSize,
-                                   float minFreq, float maxFreq)
+                                   float minFreq, float maxFreq,
+                                   DifferenceMethod method)
     : sampleRate_(sampleRate)
     , bufferSize_(bufferSize)
     , minFreq_(minFreq)
     , maxFreq_(maxFreq)
     , confidenceThreshold_(0.15f) // YIN default threshold
+    , method_(method)
+    , differenceFunction_(nullptr)
+    , cmndf_(nullptr)
+    , specialized_(nullptr)
+    , differenceValid_(false)
+    , hopsSinceRefresh_(0)
+    , trackingEnabled_(false)
+    , trackedLag_(0.0f)
+    , trackedFrames_(0)
 {
     // Calculate lag bounds from frequency range
     // lag = sampleRate / frequency
@@ -23,24 +72,75 @@ PitchDetectorYin::PitchDetectorYin(float sampleRate, size_t bufferSize,
     maxLag_ = std::min(maxLag_, MAX_LAG - 1);
     minLag_ = std::max(minLag_, size_t(1));
 
-    // Zero working buffers
-    differenceFunction_.fill(0.0f);
-    cmndf_.fill(0.0f);
+    // FFT workspace is sized for PITCH_FRAME_SIZE; fall back for larger frames
+    bool usesFft = method_ == DifferenceMethod::Fft || method_ == DifferenceMethod::Incremental;
+    if (usesFft && bufferSize_ > PITCH_FRAME_SIZE) {
+        method_ = DifferenceMethod::Direct;
+    }
+
+    // Use constant-bound loops when a per-string geometry matches exactly
+    for (const YinSpecialization& kernel : g_specializedKernels) {
+        if (kernel.frameSize == bufferSize_
+            && kernel.minLag == minLag_
+            && kernel.maxLag == maxLag_) {
+            specialized_ = &kernel;
+            break;
+        }
+    }
+
+    previousHead_.fill(0.0f);
 }
 
 PitchEstimate PitchDetectorYin::estimate(const float* samples, size_t count) {
+    return estimate(samples, count, 0);
+}
+
+PitchEstimate PitchDetectorYin::estimate(const float* samples, size_t count, size_t hop) {
     if (!samples || count != bufferSize_) {
         return PitchEstimate(); // Invalid input
     }
 
-    // Step 1: Compute difference function
-    computeDifference(samples);
+    ScratchArena::Lease scratch(ScratchArena::Region::Detector, this);
+    differenceFunction_ = scratch.get<float>();
+    cmndf_ = scratch.get<float>(MAX_LAG);
+
+    // Another detector overwrote the incremental d(tau) history
+    if (!scratch.isPreserved()) {
+        differenceValid_ = false;
+    }
+
+    if (trackingEnabled_ && trackedLag_ > 0.0f && trackedFrames_ < TRACKING_REFRESH_FRAMES) {
+        PitchEstimate tracked = estimateTracking(samples);
+        if (tracked.isValid()) {
+            trackedFrames_++;
+            return tracked;
+        }
+    }
+
+    PitchEstimate result = estimateFull(samples, hop);
+
+    trackedLag_ = result.isValid() ? sampleRate_ / result.frequencyHz : 0.0f;
+    trackedFrames_ = 0;
+
+    return result;
+}
+
+PitchEstimate PitchDetectorYin::estimateFull(const float* samples, size_t hop) {
+    size_t tau;
 
-    // Step 2: Compute cumulative mean normalized difference
-    computeCMNDF();
+    if (method_ == DifferenceMethod::Fused) {
+        // Steps 1-3 in one pass, stopping at the first dip
+        tau = fusedSearch(samples);
+    } else {
+        // Step 1: Compute difference function
+        computeDifference(samples, hop);
 
-    // Step 3: Absolute threshold to find period
-    size_t tau = absoluteThreshold();
+        // Step 2: Compute cumulative mean normalized difference
+        computeCMNDF();
+
+        // Step 3: Absolute threshold to find period
+        tau = absoluteThreshold();
+    }
 
     if (tau == 0) {
         return PitchEstimate(); // No pitch detected
@@ -58,80 +158,199 @@ PitchEstimate PitchDetectorYin::estimate(const float* samples, size_t count) {
     return PitchEstimate(frequency, confidence);
 }
 
-void PitchDetectorYin::computeDifference(const float* samples) {
-    // YIN difference function: d(tau) = sum((samples[j] - samples[j+tau])^2)
-    for (size_t tau = 0; tau < maxLag_; ++tau) {
-        float sum = 0.0f;
-        for (size_t j = 0; j < bufferSize_ - tau; ++j) {
-            float delta = samples[j] - samples[j + tau];
-            sum += delta * delta;
+PitchEstimate PitchDetectorYin::estimateTracking(const float* samples) {
+    // Search TRACKING_SEMITONES either side of the tracked lag, keeping one
+    // extra lag on each side for the edge test and interpolation
+    size_t low = static_cast<size_t>(trackedLag_ / TRACKING_RATIO);
+    size_t high = static_cast<size_t>(trackedLag_ * TRACKING_RATIO) + 1;
+    low = std::max(low, std::max(minLag_, size_t(1)));
+    high = std::min(high, maxLag_ - 2);
+
+    if (low + 2 > high) {
+        return PitchEstimate();
+    }
+
+    float energy = YinKernel::energy(samples, bufferSize_);
+
+    // Period check: a dip at 1/2 or 1/3 of the tracked lag means the note
+    // moved up (octave, fifth) to a period the old lag is a multiple of,
+    // which the window around the old lag cannot see
+    float shorterDip = 1.0f;
+
+    for (uint32_t divisor = 2; divisor <= TRACKING_MAX_DIVISOR; ++divisor) {
+        size_t center = static_cast<size_t>(trackedLag_ / static_cast<float>(divisor) + 0.5f);
+        if (center < minLag_ + 1 || center + 2 >= low) {
+            continue;
+        }
+
+        float probe[3];
+        YinKernel::normalizedDifference(samples, bufferSize_, energy,
+                                        center - 1, center + 1, probe);
+        shorterDip = std::min({shorterDip, probe[0], probe[1], probe[2]});
+    }
+
+    // Normalized difference over the window, stored in cmndf_ so the usual
+    // interpolation applies
+    float* window = cmndf_ + (low - 1);
+    YinKernel::normalizedDifference(samples, bufferSize_, energy, low - 1, high + 1, window);
+
+    size_t bestTau = low;
+    for (size_t tau = low + 1; tau <= high; ++tau) {
+        if (cmndf_[tau] < cmndf_[bestTau]) {
+            bestTau = tau;
         }
-        differenceFunction_[tau] = sum;
     }
+
+    // The incremental d(tau) history no longer matches this window
+    differenceValid_ = false;
+
+    // Dip on the window edge (pitch moved away), too shallow, or a shorter
+    // period present: full search
+    bool onEdge = bestTau == low || bestTau == high;
+    bool movedUp = shorterDip < confidenceThreshold_;
+    if (onEdge || movedUp || cmndf_[bestTau] >= confidenceThreshold_) {
+        return PitchEstimate();
+    }
+
+    trackedLag_ = parabolicInterpolation(bestTau);
+
+    return PitchEstimate(sampleRate_ / trackedLag_, 1.0f - cmndf_[bestTau]);
 }
 
-void PitchDetectorYin::computeCMNDF() {
-    // Cumulative mean normalized difference function
-    // cmndf(0) = 1 by definition
-    cmndf_[0] = 1.0f;
+void PitchDetectorYin::computeDifference(const float* samples, size_t hop) {
+    if (method_ == DifferenceMethod::Direct) {
+        computeDifferenceDirect(samples);
+        return;
+    }
 
-    float runningSum = 0.0f;
+    if (method_ == DifferenceMethod::Fft) {
+        computeDifferenceFft(samples);
+        return;
+    }
 
-    for (size_t tau = 1; tau < maxLag_; ++tau) {
-        runningSum += differenceFunction_[tau];
+    // Incremental: the leaving terms need previous-window samples
+    // [0, hop + maxLag), and the entering terms must not reach back into
+    // them, so hop + maxLag must fit inside the window
+    bool canSlide = differenceValid_
+                 && hop > 0
+                 && hop <= MAX_INCREMENTAL_HOP
+                 && hop + maxLag_ <= bufferSize_
+                 && hopsSinceRefresh_ < INCREMENTAL_REFRESH_HOPS;
 
-        if (runningSum == 0.0f) {
-            cmndf_[tau] = 1.0f; // Avoid division by zero
+    if (canSlide) {
+        updateDifferenceIncremental(samples, hop);
+        hopsSinceRefresh_++;
+    } else {
+        if (bufferSize_ <= PITCH_FRAME_SIZE) {
+            computeDifferenceFft(samples);
         } else {
-            cmndf_[tau] = differenceFunction_[tau] / (runningSum / static_cast<float>(tau));
+            computeDifferenceDirect(samples);
         }
+        hopsSinceRefresh_ = 0;
     }
+
+    // Remember the samples that will leave on the next hop
+    size_t headCount = std::min(bufferSize_, MAX_INCREMENTAL_HOP);
+    std::memcpy(previousHead_.data(), samples, headCount * sizeof(float));
+    differenceValid_ = true;
 }
 
-size_t PitchDetectorYin::absoluteThreshold() {
-    // Find first local minimum below threshold in valid lag range
-    for (size_t tau = minLag_; tau < maxLag_ - 1; ++tau) {
-        if (cmndf_[tau] < confidenceThreshold_) {
-            // Check if local minimum (value less than neighbors)
-            if (cmndf_[tau] < cmndf_[tau + 1]) {
-                return tau;
-            }
-        }
-    }
+void PitchDetectorYin::updateDifferenceIncremental(const float* samples, size_t hop) {
+    // Previous window p[k] and new window x[k] = p[k + hop]. For each lag:
+    //   d_new(tau) = d_old(tau)
+    //              - sum((p[j] - p[j+tau])^2),   j = 0 .. hop-1        (left)
+    //              + sum((x[j] - x[j+tau])^2),   j = N-tau-hop .. N-tau-1 (entered)
+    // p[k] for k < hop is previousHead_; p[k] for k >= hop is x[k - hop].
+    const float* head = previousHead_.data();
+    size_t n = bufferSize_;
 
-    // If no threshold crossing, find global minimum
-    size_t minIdx = minLag_;
-    float minVal = cmndf_[minLag_];
+    for (size_t tau = 0; tau < maxLag_; ++tau) {
+        // Leaving pairs: partner still in the old head for j < hop - tau,
+        // otherwise already part of the new window at x[j + tau - hop]
+        // (indexed, not a pointer: samples + tau - hop is out of bounds
+        // while tau < hop)
+        size_t split = (tau < hop) ? hop - tau : 0;
 
-    for (size_t tau = minLag_ + 1; tau < maxLag_; ++tau) {
-        if (cmndf_[tau] < minVal) {
-            minVal = cmndf_[tau];
-            minIdx = tau;
+        float leaving = 0.0f;
+        for (size_t j = 0; j < split; ++j) {
+            float delta = head[j] - head[j + tau];
+            leaving += delta * delta;
+        }
+        for (size_t j = split; j < hop; ++j) {
+            float delta = head[j] - samples[j + tau - hop];
+            leaving += delta * delta;
+        }
+
+        float entering = 0.0f;
+        for (size_t j = n - tau - hop; j < n - tau; ++j) {
+            float delta = samples[j] - samples[j + tau];
+            entering += delta * delta;
         }
+
+        float d = differenceFunction_[tau] - leaving + entering;
+        differenceFunction_[tau] = (d > 0.0f) ? d : 0.0f; // Clamp rounding noise
     }
+}
 
-    // Only return if confidence is reasonable
-    if (minVal < 0.5f) {
-        return minIdx;
+void PitchDetectorYin::computeDifferenceDirect(const float* samples) {
+    if (specialized_) {
+        specialized_->difference(samples, differenceFunction_);
+    } else {
+        YinKernel::difference(samples, differenceFunction_, bufferSize_, maxLag_);
     }
+}
+
+void PitchDetectorYin::computeDifferenceFft(const float* samples) {
+    // Expand the square: d(tau) = e_head(tau) + e_tail(tau) - 2 * acf(tau)
+    //   e_head(tau) = sum(x[j]^2),    j = 0 .. N-1-tau
+    //   e_tail(tau) = sum(x[j]^2),    j = tau .. N-1
+    //   acf(tau)    = sum(x[j] * x[j+tau]), j = 0 .. N-1-tau
+    const float* acf = Autocorrelation::compute(samples, bufferSize_);
+
+    // Frame energy (acf at lag 0 would do too, but this avoids FFT rounding)
+    float energy = YinKernel::energy(samples, bufferSize_);
 
-    return 0; // No valid pitch
+    // Walk the running energy terms down as the overlap shrinks
+    float headEnergy = energy;
+    float tailEnergy = energy;
+
+    for (size_t tau = 0; tau < maxLag_; ++tau) {
+        float d = headEnergy + tailEnergy - 2.0f * acf[tau];
+        differenceFunction_[tau] = (d > 0.0f) ? d : 0.0f; // Clamp rounding noise
+
+        float leavingHead = samples[bufferSize_ - 1 - tau];
+        float leavingTail = samples[tau];
+        headEnergy -= leavingHead * leavingHead;
+        tailEnergy -= leavingTail * leavingTail;
+    }
 }
 
-float PitchDetectorYin::parabolicInterpolation(size_t tau) {
-    // Parabolic interpolation for sub-sample accuracy
-    if (tau < 1 || tau >= maxLag_ - 1) {
-        return static_cast<float>(tau); // Can't interpolate at boundaries
+void PitchDetectorYin::computeCMNDF() {
+    if (specialized_) {
+        specialized_->cmndf(differenceFunction_, cmndf_);
+    } else {
+        YinKernel::cmndf(differenceFunction_, cmndf_, maxLag_);
     }
+}
 
-    float s0 = cmndf_[tau - 1];
-    float s1 = cmndf_[tau];
-    float s2 = cmndf_[tau + 1];
+size_t PitchDetectorYin::absoluteThreshold() {
+    if (specialized_) {
+        return specialized_->absoluteThreshold(cmndf_, confidenceThreshold_);
+    }
+    return YinKernel::absoluteThreshold(cmndf_, confidenceThreshold_, minLag_, maxLag_);
+}
 
-    // Find vertex of parabola through three points
-    float adjustment = (s2 - s0) / (2.0f * (2.0f * s1 - s2 - s0));
+size_t PitchDetectorYin::fusedSearch(const float* samples) {
+    if (specialized_) {
+        return specialized_->fusedSearch(samples, differenceFunction_, cmndf_,
+                                         confidenceThreshold_);
+    }
+    return YinKernel::fusedSearch(samples, differenceFunction_, cmndf_,
+                                  confidenceThreshold_, bufferSize_, minLag_, maxLag_);
+}
 
-    return static_cast<float>(tau) + adjustment;
+float PitchDetectorYin::parabolicInterpolation(size_t tau) {
+    return YinKernel::parabolicInterpolation(cmndf_, tau, maxLag_);
 }
 
 } // namespace BassMINT
@@ -1,12 +1,17 @@
 #pragma once
 
 #include "core/Types.h"
+#include "dsp/AnalysisGeometry.h"
+#include "dsp/PitchDetector.h"
+#include "dsp/ScratchArena.h"
 #include <cstddef>
 #include <cstdint>
 #include <array>
 
 namespace BassMINT {
 
+struct YinSpecialization; // Defined in PitchDetectorYin.cpp
+
 /**
  * @brief YIN pitch detection algorithm optimized for bass guitar
  *
@@ -22,20 +27,81 @@ namespace BassMINT {
  * - Min freq ~30 Hz (below E1 for headroom)
  * - Max freq ~400 Hz (above typical bass range)
  * - Window size chosen for low latency while resolving E1
+ *
+ * Difference function methods:
+ * - Direct: brute-force O(N * maxLag) double loop (reference)
+ * - Fft: energy terms + FFT autocorrelation, O(N log N). Matches Direct
+ *   to within float rounding (frequency within 0.01%, confidence within
+ *   0.001 on synthetic bass plucks).
+ * - Incremental: for overlapping windows, d(tau) is updated from the
+ *   previous window by subtracting the terms that left and adding the
+ *   terms that entered, O(hop * maxLag). A full (FFT) recompute runs
+ *   every INCREMENTAL_REFRESH_HOPS updates to bound float drift, and
+ *   whenever the hop is unknown or too large.
+ * - Fused: Direct, but d(tau), CMNDF and the threshold test run in one
+ *   loop that stops one lag after the first dip below the threshold.
+ *   Same result as Direct; high notes skip most of the lag range.
+ *
+ * Tracking (optional): once a pitch is found, later frames evaluate only
+ * the lags within TRACKING_SEMITONES of it, scoring them with the
+ * energy-normalized difference d(tau) / (e_head + e_tail) since the CMNDF
+ * needs every lag below tau. The full search takes over again when the
+ * tracked dip leaves the window or rises above the threshold, after
+ * TRACKING_REFRESH_FRAMES tracked frames (bounds octave lock-in), and
+ * after clearTrackingHint() (StringProcessor calls it on re-attack).
+ *
+ * The per-lag loops live in YinKernel. When the frame size and lag range
+ * match a per-string AnalysisGeometry, the constructor selects the
+ * StaticYinKernel instantiation for it, so the runtime class runs the
+ * same constant-bound loops as StaticPitchDetectorYin.
  */
-class PitchDetectorYin {
+class PitchDetectorYin : public PitchDetector {
 public:
+    /**
+     * @brief How the YIN difference function d(tau) is computed
+     */
+    enum class DifferenceMethod : uint8_t {
+        Direct,      // Brute-force sum of squared differences
+        Fft,         // d(tau) = r(0)[0..N-tau) + r(0)[tau..N) - 2 * acf(tau) via FFT
+        Incremental, // Slide d(tau) across overlapping windows, periodic full refresh
+        Fused        // Direct, lag by lag with CMNDF + threshold, stops after the first dip
+    };
+
+    /**
+     * @brief Largest hop the Incremental method can update across
+     *
+     * Beyond this the update costs as much as a full recompute.
+     */
+    static constexpr size_t MAX_INCREMENTAL_HOP = 256;
+
+    /**
+     * @brief Incremental updates between full recomputes
+     */
+    static constexpr uint32_t INCREMENTAL_REFRESH_HOPS = 16;
+
+    /**
+     * @brief Half-width of the tracking search window in semitones
+     */
+    static constexpr int TRACKING_SEMITONES = 2;
+
+    /**
+     * @brief Tracked frames between forced full searches
+     */
+    static constexpr uint32_t TRACKING_REFRESH_FRAMES = 8;
+
     /**
      * @brief Constructor
      * @param sampleRate Sample rate in Hz (e.g., 8000)
      * @param bufferSize Analysis window size in samples (e.g., 512)
      * @param minFreq Minimum detectable frequency in Hz (e.g., 30)
      * @param maxFreq Maximum detectable frequency in Hz (e.g., 400)
+     * @param method Difference function method (Fft / Incremental require bufferSize <= PITCH_FRAME_SIZE)
      */
     PitchDetectorYin(float sampleRate = SAMPLE_RATE_HZ,
                      size_t bufferSize = PITCH_FRAME_SIZE,
                      float minFreq = 30.0f,
-                     float maxFreq = 400.0f);
+                     float maxFreq = 400.0f,
+                     DifferenceMethod method = DifferenceMethod::Direct);
 
     /**
      * @brief Estimate pitch from audio buffer
@@ -45,43 +111,151 @@ public:
      */
     PitchEstimate estimate(const float* samples, size_t count);
 
+    /**
+     * @brief Estimate pitch from a window that slid forward by 'hop' samples
+     * @param samples Input audio samples (length = bufferSize)
+     * @param count Number of samples (must equal bufferSize)
+     * @param hop Samples the window advanced since the previous call
+     *            (0 = unrelated window, forces a full recompute)
+     * @return Pitch estimate with frequency and confidence
+     *
+     * Only the Incremental method uses 'hop'; others ignore it.
+     */
+    PitchEstimate estimate(const float* samples, size_t count, size_t hop) override;
+
+    /**
+     * @brief Forget sliding-window history (next estimate recomputes fully)
+     */
+    void reset() override {
+        differenceValid_ = false;
+        hopsSinceRefresh_ = 0;
+        clearTrackingHint();
+    }
+
+    /**
+     * @brief Enable narrow-window tracking around the previous estimate
+     */
+    void setTrackingEnabled(bool enabled) {
+        trackingEnabled_ = enabled;
+        clearTrackingHint();
+    }
+
+    /**
+     * @brief Check if tracking is enabled
+     */
+    bool isTrackingEnabled() const {
+        return trackingEnabled_;
+    }
+
+    /**
+     * @brief Drop the tracked lag (next estimate runs the full search)
+     */
+    void clearTrackingHint() override {
+        trackedLag_ = 0.0f;
+        trackedFrames_ = 0;
+    }
+
     /**
      * @brief Set confidence threshold for valid pitch
      * @param threshold Minimum confidence (0.0-1.0)
      */
-    void setConfidenceThreshold(float threshold) {
+    void setConfidenceThreshold(float threshold) override {
         confidenceThreshold_ = threshold;
     }
 
     /**
      * @brief Get current confidence threshold
      */
-    float getConfidenceThreshold() const {
+    float getConfidenceThreshold() const override {
         return confidenceThreshold_;
     }
 
+    /**
+     * @brief Get difference function method in use
+     */
+    DifferenceMethod getDifferenceMethod() const {
+        return method_;
+    }
+
 private:
     float sampleRate_;
     size_t bufferSize_;
     float minFreq_;
     float maxFreq_;
     float confidenceThreshold_;
+    DifferenceMethod method_;
 
     // Pre-calculated lag bounds
     size_t minLag_;
     size_t maxLag_;
 
-    // Working buffers (avoid dynamic allocation)
-    // MAX_LAG must accommodate PITCH_FRAME_SIZE/2 for full frequency range
-    static constexpr size_t MAX_LAG = 1024;
-    std::array<float, MAX_LAG> differenceFunction_;
-    std::array<float, MAX_LAG> cmndf_;
+    // Working buffers, borrowed from the ScratchArena Detector region for
+    // the duration of estimate() (dangling in between)
+    // maxLag_ never exceeds PITCH_FRAME_SIZE/2 for the frames StringProcessor
+    // feeds; StaticPitchDetectorYin sizes these exactly per geometry
+    static constexpr size_t MAX_LAG = PITCH_FRAME_SIZE / 2 + 1;
+    float* differenceFunction_;
+    float* cmndf_;
+
+    static_assert(2 * MAX_LAG * sizeof(float) <= ScratchArena::DETECTOR_BYTES,
+                  "YIN working buffers exceed the scratch region");
+
+    // Compile-time specialized kernels for this frame size / lag range,
+    // or nullptr when the configuration matches no per-string geometry
+    const YinSpecialization* specialized_;
+
+    // Incremental method state: head of the previous window (the samples
+    // that leave on the next hop) and refresh bookkeeping. d(tau) itself
+    // stays in the arena, valid only while no other owner borrowed it
+    std::array<float, MAX_INCREMENTAL_HOP> previousHead_;
+    bool differenceValid_;
+    uint32_t hopsSinceRefresh_;
+
+    // Tracking state: refined lag of the last estimate (0 = none) and
+    // tracked frames since the last full search
+    bool trackingEnabled_;
+    float trackedLag_;
+    uint32_t trackedFrames_;
+
+    /**
+     * @brief Full YIN search over [minLag, maxLag)
+     * @param samples Input samples
+     * @param hop Samples the window advanced since the previous call
+     */
+    PitchEstimate estimateFull(const float* samples, size_t hop);
+
+    /**
+     * @brief Narrow search around trackedLag_
+     * @param samples Input samples
+     * @return Estimate, or invalid if the full search is needed
+     */
+    PitchEstimate estimateTracking(const float* samples);
 
     /**
      * @brief Compute difference function
      * @param samples Input samples
+     * @param hop Samples the window advanced since the previous call
+     */
+    void computeDifference(const float* samples, size_t hop);
+
+    /**
+     * @brief Slide the previous d(tau) forward by 'hop' samples
+     * @param samples New window
+     * @param hop Samples the window advanced
+     */
+    void updateDifferenceIncremental(const float* samples, size_t hop);
+
+    /**
+     * @brief Brute-force difference function (O(N * maxLag))
+     * @param samples Input samples
      */
-    void computeDifference(const float* samples);
+    void computeDifferenceDirect(const float* samples);
+
+    /**
+     * @brief FFT-based difference function (O(N log N))
+     * @param samples Input samples
+     */
+    void computeDifferenceFft(const float* samples);
 
     /**
      * @brief Compute cumulative mean normalized difference
@@ -94,6 +268,13 @@ private:
      */
     size_t absoluteThreshold();
 
+    /**
+     * @brief Difference, CMNDF and threshold in one early-exit pass
+     * @param samples Input samples
+     * @return Lag of minimum, or 0 if none found
+     */
+    size_t fusedSearch(const float* samples);
+
     /**
      * @brief Parabolic interpolation for sub-sample accuracy
      * @param tau Integer lag estimate
@@ -0,0 +1,191 @@
+#include "dsp/PitchDetectorYinFixed.h"
+#include <algorithm>
+
+namespace BassMINT {
+
+// Squared 12-bit deltas are < 2^24, so 256 of them fit a 32-bit partial sum
+static constexpr size_t ACCUM_CHUNK = 256;
+
+// Global-minimum fallback limit (0.5 in Q15), as in PitchDetectorYin
+static constexpr uint32_t FALLBACK_LIMIT_Q15 = 1u << 14;
+
+PitchDetectorYinFixed::PitchDetectorYinFixed(uint32_t sampleRate, size_t bufferSize,
+                                             float minFreq, float maxFreq)
+    : sampleRate_(sampleRate)
+    , bufferSize_(bufferSize)
+    , differenceFunction_(nullptr)
+    , cmndf_(nullptr)
+{
+    setConfidenceThreshold(0.15f); // YIN default threshold
+
+    // Calculate lag bounds from frequency range (construction time only)
+    maxLag_ = static_cast<size_t>(static_cast<float>(sampleRate_) / minFreq);
+    minLag_ = static_cast<size_t>(static_cast<float>(sampleRate_) / maxFreq);
+
+    // Clamp to buffer size and MAX_LAG
+    maxLag_ = std::min(maxLag_, bufferSize_ / 2);
+    maxLag_ = std::min(maxLag_, MAX_LAG - 1);
+    minLag_ = std::max(minLag_, size_t(1));
+}
+
+void PitchDetectorYinFixed::setConfidenceThreshold(float threshold) {
+    float clamped = std::clamp(threshold, 0.0f, 1.0f);
+    thresholdQ15_ = static_cast<uint32_t>(clamped * static_cast<float>(Q15_ONE));
+}
+
+PitchEstimate PitchDetectorYinFixed::estimate(const uint16_t* samples, size_t count) {
+    if (!samples || count != bufferSize_) {
+        return PitchEstimate(); // Invalid input
+    }
+
+    // d(tau) first, CMNDF right behind it (offset in uint16_t units)
+    ScratchArena::Lease scratch(ScratchArena::Region::Detector, this);
+    differenceFunction_ = scratch.get<uint32_t>();
+    cmndf_ = scratch.get<uint16_t>(2 * MAX_LAG);
+
+    // Step 1: Compute difference function
+    computeDifference(samples);
+
+    // Step 2: Compute cumulative mean normalized difference
+    computeCMNDF();
+
+    // Step 3: Absolute threshold to find period
+    size_t tau = absoluteThreshold();
+
+    if (tau == 0) {
+        return PitchEstimate(); // No pitch detected
+    }
+
+    // Step 4: Parabolic interpolation for better accuracy
+    uint32_t refinedTauQ15 = parabolicInterpolation(tau);
+
+    // Convert lag to frequency: Q16 Hz = (sampleRate << 31) / Q15 lag
+    uint64_t frequencyQ16 = (static_cast<uint64_t>(sampleRate_) << 31) / refinedTauQ15;
+
+    // Confidence = 1 - CMNDF at detected lag
+    uint32_t cmndfAtTau = std::min<uint32_t>(cmndf_[tau], Q15_ONE);
+    uint32_t confidenceQ15 = Q15_ONE - cmndfAtTau;
+
+    // Single float conversion at the API boundary
+    return PitchEstimate(static_cast<float>(frequencyQ16) * (1.0f / 65536.0f),
+                         static_cast<float>(confidenceQ15) * (1.0f / 32768.0f));
+}
+
+void PitchDetectorYinFixed::computeDifference(const uint16_t* samples) {
+    // YIN difference function: d(tau) = sum((samples[j] - samples[j+tau])^2)
+    for (size_t tau = 0; tau < maxLag_; ++tau) {
+        const uint16_t* lagged = samples + tau;
+        size_t count = bufferSize_ - tau;
+        uint64_t sum = 0;
+
+        // 32-bit partial sums keep the hot loop free of 64-bit adds
+        size_t j = 0;
+        while (j < count) {
+            size_t end = std::min(count, j + ACCUM_CHUNK);
+            uint32_t partial = 0;
+            for (; j < end; ++j) {
+                int32_t delta = static_cast<int32_t>(samples[j]) - static_cast<int32_t>(lagged[j]);
+                partial += static_cast<uint32_t>(delta * delta);
+            }
+            sum += partial;
+        }
+
+        differenceFunction_[tau] = static_cast<uint32_t>(sum >> DIFF_SHIFT);
+    }
+}
+
+void PitchDetectorYinFixed::computeCMNDF() {
+    // cmndf(tau) = d(tau) * tau / sum(d(1..tau)), Q15
+    cmndf_[0] = static_cast<uint16_t>(Q15_ONE);
+
+    uint64_t runningSum = 0;
+
+    for (size_t tau = 1; tau < maxLag_; ++tau) {
+        runningSum += differenceFunction_[tau];
+
+        if (runningSum == 0) {
+            cmndf_[tau] = static_cast<uint16_t>(Q15_ONE); // Avoid division by zero
+            continue;
+        }
+
+        uint64_t numerator = static_cast<uint64_t>(differenceFunction_[tau]) * tau;
+        uint64_t denominator = runningSum;
+
+        // Normalize the denominator below 2^16 so the Q15 quotient is a
+        // 32-bit division (RP2040 hardware divider)
+        if (denominator >= (1u << 16)) {
+            int shift = 48 - __builtin_clzll(denominator);
+            numerator >>= shift;
+            denominator >>= shift;
+        }
+
+        uint32_t value;
+        if (numerator >= 2 * denominator) {
+            value = Q15_MAX; // Saturate at ~2.0
+        } else {
+            value = (static_cast<uint32_t>(numerator) << 15) / static_cast<uint32_t>(denominator);
+            value = std::min(value, Q15_MAX);
+        }
+
+        cmndf_[tau] = static_cast<uint16_t>(value);
+    }
+}
+
+size_t PitchDetectorYinFixed::absoluteThreshold() const {
+    // Find first local minimum below threshold in valid lag range
+    for (size_t tau = minLag_; tau < maxLag_ - 1; ++tau) {
+        if (cmndf_[tau] < thresholdQ15_) {
+            // Check if local minimum (value less than neighbors)
+            if (cmndf_[tau] < cmndf_[tau + 1]) {
+                return tau;
+            }
+        }
+    }
+
+    // If no threshold crossing, find global minimum
+    size_t minIdx = minLag_;
+    uint32_t minVal = cmndf_[minLag_];
+
+    for (size_t tau = minLag_ + 1; tau < maxLag_; ++tau) {
+        if (cmndf_[tau] < minVal) {
+            minVal = cmndf_[tau];
+            minIdx = tau;
+        }
+    }
+
+    // Only return if confidence is reasonable
+    if (minVal < FALLBACK_LIMIT_Q15) {
+        return minIdx;
+    }
+
+    return 0; // No valid pitch
+}
+
+uint32_t PitchDetectorYinFixed::parabolicInterpolation(size_t tau) const {
+    uint32_t tauQ15 = static_cast<uint32_t>(tau) << 15;
+
+    // Can't interpolate at boundaries
+    if (tau < 1 || tau >= maxLag_ - 1) {
+        return tauQ15;
+    }
+
+    int32_t s0 = cmndf_[tau - 1];
+    int32_t s1 = cmndf_[tau];
+    int32_t s2 = cmndf_[tau + 1];
+
+    // Vertex of parabola: adjustment = (s2 - s0) / (2 * (2*s1 - s2 - s0))
+    int32_t curvature = 2 * s1 - s2 - s0;
+    if (curvature == 0) {
+        return tauQ15;
+    }
+
+    // (s2 - s0) is 17-bit signed, so << 14 stays within int32
+    int32_t adjustmentQ15 = ((s2 - s0) * (1 << 14)) / curvature;
+    adjustmentQ15 = std::clamp(adjustmentQ15,
+                               -static_cast<int32_t>(Q15_ONE),
+                               static_cast<int32_t>(Q15_ONE));
+
+    return static_cast<uint32_t>(static_cast<int32_t>(tauQ15) + adjustmentQ15);
+}
+
+} // namespace BassMINT
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Types.h"
+#include "dsp/ScratchArena.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Fixed-point YIN pitch detector for the FPU-less Cortex-M0+
+ *
+ * Integer twin of PitchDetectorYin that works directly on raw 12-bit ADC
+ * samples. Every per-lag step (difference, CMNDF, threshold, parabolic
+ * interpolation) is integer-only; float appears once per frame when the
+ * result is packed into a PitchEstimate.
+ *
+ * Number formats:
+ * - Difference: raw deltas are 13-bit, squares < 2^24, sums accumulate
+ *   in 64 bits and are stored >> DIFF_SHIFT in 32 bits
+ * - CMNDF / threshold / confidence: unsigned Q15 (32768 = 1.0),
+ *   saturating at 0xFFFF (~2.0)
+ * - Refined lag: Q15 samples; frequency computed as Q16 Hz
+ *
+ * DC offset cancels in (x[j] - x[j+tau]), so no centering is needed.
+ *
+ * Selected with the BASSMINT_FIXED_POINT_YIN build option.
+ */
+class PitchDetectorYinFixed {
+public:
+    /**
+     * @brief Constructor
+     * @param sampleRate Sample rate in Hz (e.g., 8000)
+     * @param bufferSize Analysis window size in samples (e.g., 1024)
+     * @param minFreq Minimum detectable frequency in Hz (e.g., 30)
+     * @param maxFreq Maximum detectable frequency in Hz (e.g., 400)
+     */
+    PitchDetectorYinFixed(uint32_t sampleRate = SAMPLE_RATE_HZ,
+                          size_t bufferSize = PITCH_FRAME_SIZE,
+                          float minFreq = 30.0f,
+                          float maxFreq = 400.0f);
+
+    /**
+     * @brief Estimate pitch from raw ADC samples
+     * @param samples 12-bit ADC samples (length = bufferSize)
+     * @param count Number of samples (must equal bufferSize)
+     * @return Pitch estimate with frequency and confidence
+     */
+    PitchEstimate estimate(const uint16_t* samples, size_t count);
+
+    /**
+     * @brief Set confidence threshold for valid pitch
+     * @param threshold Minimum confidence (0.0-1.0), stored as Q15
+     */
+    void setConfidenceThreshold(float threshold);
+
+    /**
+     * @brief Get current confidence threshold
+     */
+    float getConfidenceThreshold() const {
+        return static_cast<float>(thresholdQ15_) / static_cast<float>(Q15_ONE);
+    }
+
+private:
+    static constexpr uint32_t Q15_ONE = 1u << 15;
+    static constexpr uint32_t Q15_MAX = 0xFFFF;
+    static constexpr uint32_t DIFF_SHIFT = 2; // 1024 * 2^24 >> 2 fits in 32 bits
+
+    uint32_t sampleRate_;
+    size_t bufferSize_;
+    uint32_t thresholdQ15_;
+
+    // Pre-calculated lag bounds
+    size_t minLag_;
+    size_t maxLag_;
+
+    // Working buffers, borrowed from the ScratchArena Detector region for
+    // the duration of estimate()
+    static constexpr size_t MAX_LAG = PITCH_FRAME_SIZE / 2 + 1;
+    uint32_t* differenceFunction_;
+    uint16_t* cmndf_;
+
+    static_assert(MAX_LAG * (sizeof(uint32_t) + sizeof(uint16_t)) <= ScratchArena::DETECTOR_BYTES,
+                  "Fixed-point YIN buffers exceed the scratch region");
+
+    /**
+     * @brief Compute difference function (64-bit accumulation)
+     * @param samples Raw ADC samples
+     */
+    void computeDifference(const uint16_t* samples);
+
+    /**
+     * @brief Compute cumulative mean normalized difference in Q15
+     */
+    void computeCMNDF();
+
+    /**
+     * @brief Find absolute threshold minimum in CMNDF
+     * @return Lag of minimum, or 0 if none found
+     */
+    size_t absoluteThreshold() const;
+
+    /**
+     * @brief Parabolic interpolation for sub-sample accuracy
+     * @param tau Integer lag estimate
+     * @return Refined lag in Q15 samples
+     */
+    uint32_t parabolicInterpolation(size_t tau) const;
+};
+
+} // namespace BassMINT
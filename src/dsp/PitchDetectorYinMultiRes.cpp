@@ -0,0 +1,85 @@
+#include "dsp/PitchDetectorYinMultiRes.h"
+#include "dsp/YinKernel.h"
+#include <algorithm>
+
+namespace BassMINT {
+
+// Refine window: +/- factor lags around the coarse lag, plus one each side
+static constexpr size_t MAX_REFINE_LAGS = 2 * PitchDetectorYinMultiRes::MAX_FACTOR + 4;
+
+static size_t clampFactor(size_t factor) {
+    return std::clamp(factor, size_t(2), PitchDetectorYinMultiRes::MAX_FACTOR);
+}
+
+PitchDetectorYinMultiRes::PitchDetectorYinMultiRes(float sampleRate, size_t bufferSize,
+                                                   float minFreq, float maxFreq,
+                                                   size_t factor)
+    : sampleRate_(sampleRate)
+    , bufferSize_(std::min(bufferSize, static_cast<size_t>(PITCH_FRAME_SIZE)))
+    , decimator_(clampFactor(factor))
+    , decimatedSize_(decimator_.getOutputSize(bufferSize_))
+    , coarse_(sampleRate / static_cast<float>(clampFactor(factor)), decimatedSize_,
+              minFreq, maxFreq, PitchDetectorYin::DifferenceMethod::Fused)
+{
+    // Calculate lag bounds from frequency range
+    maxLag_ = static_cast<size_t>(sampleRate_ / minFreq);
+    minLag_ = static_cast<size_t>(sampleRate_ / maxFreq);
+
+    // Clamp to buffer size
+    maxLag_ = std::min(maxLag_, bufferSize_ / 2);
+    minLag_ = std::max(minLag_, size_t(1));
+
+    decimated_.fill(0.0f);
+}
+
+PitchEstimate PitchDetectorYinMultiRes::estimate(const float* samples, size_t count) {
+    if (!samples || count != bufferSize_) {
+        return PitchEstimate(); // Invalid input
+    }
+
+    // Stage 1: coarse YIN on the decimated frame
+    decimator_.process(samples, bufferSize_, decimated_.data());
+    PitchEstimate coarse = coarse_.estimate(decimated_.data(), decimatedSize_);
+
+    if (!coarse.isValid()) {
+        return PitchEstimate(); // No pitch detected
+    }
+
+    // Stage 2: full-rate refinement around the coarse period
+    return refine(samples, sampleRate_ / coarse.frequencyHz);
+}
+
+PitchEstimate PitchDetectorYinMultiRes::refine(const float* samples, float coarseLag) const {
+    size_t factor = decimator_.getFactor();
+    size_t center = static_cast<size_t>(coarseLag + 0.5f);
+
+    size_t low = (center > factor) ? center - factor : 1;
+    size_t high = center + factor;
+    low = std::max(low, std::max(minLag_, size_t(2)));
+    high = std::min(high, maxLag_ - 2);
+
+    if (low > high) {
+        return PitchEstimate();
+    }
+
+    // Normalized difference on [low - 1, high + 1]
+    std::array<float, MAX_REFINE_LAGS> normalized;
+    size_t first = low - 1;
+    size_t last = high + 1;
+    float energy = YinKernel::energy(samples, bufferSize_);
+    YinKernel::normalizedDifference(samples, bufferSize_, energy, first, last, normalized.data());
+
+    size_t best = low - first;
+    for (size_t k = best + 1; k <= high - first; ++k) {
+        if (normalized[k] < normalized[best]) {
+            best = k;
+        }
+    }
+
+    float refined = static_cast<float>(first)
+                  + YinKernel::parabolicInterpolation(normalized.data(), best, last - first + 1);
+
+    return PitchEstimate(sampleRate_ / refined, 1.0f - normalized[best]);
+}
+
+} // namespace BassMINT
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "core/Types.h"
+#include "dsp/Decimator.h"
+#include "dsp/PitchDetectorYin.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief Two-stage (coarse + refine) YIN pitch detector
+ *
+ * Bass fundamentals sit far below the 4 kHz Nyquist, so the lag search
+ * does not need full rate:
+ * 1. Low-pass and decimate the frame by 2 or 4 (Decimator), then run YIN
+ *    (Fused) on the short copy: ~factor^2 less work for the whole range.
+ * 2. At full rate, evaluate the energy-normalized difference only within
+ *    +/- factor lags of the coarse period and interpolate its minimum for
+ *    sub-sample accuracy.
+ *
+ * The coarse stage decides voiced/unvoiced and the octave; the refine
+ * stage only sharpens the lag and supplies the confidence.
+ */
+class PitchDetectorYinMultiRes {
+public:
+    static constexpr size_t MAX_FACTOR = 4;
+    static constexpr size_t DECIMATOR_TAPS = 31;
+
+    /**
+     * @brief Constructor
+     * @param sampleRate Sample rate in Hz (e.g., 8000)
+     * @param bufferSize Analysis window size in samples (<= PITCH_FRAME_SIZE)
+     * @param minFreq Minimum detectable frequency in Hz (e.g., 30)
+     * @param maxFreq Maximum detectable frequency in Hz (e.g., 400)
+     * @param factor Decimation factor for the coarse stage (2..MAX_FACTOR)
+     */
+    PitchDetectorYinMultiRes(float sampleRate = SAMPLE_RATE_HZ,
+                             size_t bufferSize = PITCH_FRAME_SIZE,
+                             float minFreq = 30.0f,
+                             float maxFreq = 400.0f,
+                             size_t factor = MAX_FACTOR);
+
+    /**
+     * @brief Estimate pitch from audio buffer
+     * @param samples Input audio samples (length = bufferSize)
+     * @param count Number of samples (must equal bufferSize)
+     * @return Pitch estimate with frequency and confidence
+     */
+    PitchEstimate estimate(const float* samples, size_t count);
+
+    /**
+     * @brief Set confidence threshold for valid pitch (coarse stage)
+     * @param threshold Minimum confidence (0.0-1.0)
+     */
+    void setConfidenceThreshold(float threshold) {
+        coarse_.setConfidenceThreshold(threshold);
+    }
+
+    /**
+     * @brief Get current confidence threshold
+     */
+    float getConfidenceThreshold() const {
+        return coarse_.getConfidenceThreshold();
+    }
+
+    /**
+     * @brief Get decimation factor of the coarse stage
+     */
+    size_t getFactor() const { return decimator_.getFactor(); }
+
+private:
+    float sampleRate_;
+    size_t bufferSize_;
+
+    // Full-rate lag bounds for the refine stage
+    size_t minLag_;
+    size_t maxLag_;
+
+    Decimator<DECIMATOR_TAPS> decimator_;
+    size_t decimatedSize_;
+    std::array<float, PITCH_FRAME_SIZE / 2> decimated_;
+    PitchDetectorYin coarse_;
+
+    /**
+     * @brief Full-rate normalized-difference minimum near a coarse lag
+     * @param samples Full-rate frame
+     * @param coarseLag Coarse period in full-rate samples
+     */
+    PitchEstimate refine(const float* samples, float coarseLag) const;
+};
+
+} // namespace BassMINT
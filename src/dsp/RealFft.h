@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cmath>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief Fixed-size, allocation-free real FFT
+ *
+ * Radix-2 complex FFT of length N/2 plus the standard split step to
+ * recover the spectrum of N real samples. Twiddles are stored as a
+ * quarter-wave cosine table (N/4 + 1 floats), so an N = 2048 instance
+ * costs ~2 KB of RAM and no working memory beyond the caller's buffer.
+ *
+ * Packed spectrum layout (in place, N floats):
+ * - data[0]            = Re(X[0])   (DC, imaginary part is zero)
+ * - data[1]            = Re(X[N/2]) (Nyquist, imaginary part is zero)
+ * - data[2k], data[2k+1] = Re(X[k]), Im(X[k]) for k = 1 .. N/2-1
+ *
+ * @tparam N Transform length (must be power of 2, >= 8)
+ */
+template<size_t N>
+class RealFft {
+    static_assert((N & (N - 1)) == 0, "N must be power of 2");
+    static_assert(N >= 8, "N must be at least 8");
+
+public:
+    RealFft() {
+        // cos(2*pi*k/N) for k = 0 .. N/4
+        for (size_t k = 0; k <= QUARTER; ++k) {
+            cosTable_[k] = static_cast<float>(
+                std::cos(2.0 * PI * static_cast<double>(k) / static_cast<double>(N)));
+        }
+    }
+
+    /**
+     * @brief Forward transform (real -> packed spectrum)
+     * @param data N real samples in, packed spectrum out
+     */
+    void forward(float* data) const {
+        // Treat the real input as N/2 complex values and transform
+        complexFft(data, false);
+
+        // Split step: separate the even/odd real sequences
+        float dc = data[0];
+        float ny = data[1];
+        data[0] = dc + ny;
+        data[1] = dc - ny;
+
+        for (size_t k = 1; k < HALF / 2; ++k) {
+            size_t m = HALF - k;
+            float zkRe = data[2 * k];
+            float zkIm = data[2 * k + 1];
+            float zmRe = data[2 * m];
+            float zmIm = data[2 * m + 1];
+
+            // Even part E = (Z[k] + conj(Z[m])) / 2, odd part O = (Z[k] - conj(Z[m])) / 2
+            float eRe = 0.5f * (zkRe + zmRe);
+            float eIm = 0.5f * (zkIm - zmIm);
+            float oRe = 0.5f * (zkRe - zmRe);
+            float oIm = 0.5f * (zkIm + zmIm);
+
+            // X[k] = E - i * W^k * O, with W^k = exp(-2*pi*i*k/N)
+            float wRe, wIm;
+            twiddle(k, wRe, wIm);
+            float tRe = wRe * oRe - wIm * oIm;
+            float tIm = wRe * oIm + wIm * oRe;
+
+            data[2 * k] = eRe + tIm;
+            data[2 * k + 1] = eIm - tRe;
+            // X[N/2 - k] = conj(E + i * W^k * O)
+            data[2 * m] = eRe - tIm;
+            data[2 * m + 1] = -eIm - tRe;
+        }
+
+        // Middle bin (k = N/4) maps onto itself: X[N/4] = conj(Z[N/4])
+        data[HALF + 1] = -data[HALF + 1];
+    }
+
+    /**
+     * @brief Inverse transform (packed spectrum -> real)
+     * @param data Packed spectrum in, N real samples out
+     *
+     * Scaled so that inverse(forward(x)) == x.
+     */
+    void inverse(float* data) const {
+        float x0 = data[0];
+        float xn = data[1];
+        data[0] = 0.5f * (x0 + xn);
+        data[1] = 0.5f * (x0 - xn);
+
+        data[HALF + 1] = -data[HALF + 1];
+
+        for (size_t k = 1; k < HALF / 2; ++k) {
+            size_t m = HALF - k;
+            float xkRe = data[2 * k];
+            float xkIm = data[2 * k + 1];
+            float xmRe = data[2 * m];
+            float xmIm = data[2 * m + 1];
+
+            // Recover E and i * W^k * O from X[k] and conj(X[N/2 - k])
+            float eRe = 0.5f * (xkRe + xmRe);
+            float eIm = 0.5f * (xkIm - xmIm);
+            float tRe = -0.5f * (xkIm + xmIm);
+            float tIm = 0.5f * (xkRe - xmRe);
+
+            // O = conj(W^k) * t
+            float wRe, wIm;
+            twiddle(k, wRe, wIm);
+            float oRe = wRe * tRe + wIm * tIm;
+            float oIm = wRe * tIm - wIm * tRe;
+
+            // Z[k] = E + O, Z[m] = conj(E - O)
+            data[2 * k] = eRe + oRe;
+            data[2 * k + 1] = eIm + oIm;
+            data[2 * m] = eRe - oRe;
+            data[2 * m + 1] = oIm - eIm;
+        }
+
+        complexFft(data, true);
+
+        float scale = 1.0f / static_cast<float>(HALF);
+        for (size_t i = 0; i < N; ++i) {
+            data[i] *= scale;
+        }
+    }
+
+    /**
+     * @brief Get transform length
+     */
+    static constexpr size_t size() { return N; }
+
+private:
+    static constexpr size_t HALF = N / 2;
+    static constexpr size_t QUARTER = N / 4;
+    static constexpr double PI = 3.14159265358979323846;
+
+    std::array<float, QUARTER + 1> cosTable_;
+
+    /**
+     * @brief Look up W^k = exp(-2*pi*i*k/N) for k in [0, N/2)
+     */
+    void twiddle(size_t k, float& re, float& im) const {
+        if (k <= QUARTER) {
+            re = cosTable_[k];
+            im = -cosTable_[QUARTER - k];
+        } else {
+            re = -cosTable_[HALF - k];
+            im = -cosTable_[k - QUARTER];
+        }
+    }
+
+    /**
+     * @brief In-place radix-2 complex FFT of length N/2 (interleaved re/im)
+     * @param data N floats (N/2 complex values)
+     * @param inverse true for the unscaled inverse transform
+     */
+    void complexFft(float* data, bool inverse) const {
+        // Bit-reversal permutation
+        for (size_t i = 1, j = 0; i < HALF; ++i) {
+            size_t bit = HALF >> 1;
+            for (; j & bit; bit >>= 1) {
+                j ^= bit;
+            }
+            j ^= bit;
+
+            if (i < j) {
+                float tRe = data[2 * i];
+                float tIm = data[2 * i + 1];
+                data[2 * i] = data[2 * j];
+                data[2 * i + 1] = data[2 * j + 1];
+                data[2 * j] = tRe;
+                data[2 * j + 1] = tIm;
+            }
+        }
+
+        // Butterflies
+        for (size_t len = 2; len <= HALF; len <<= 1) {
+            size_t half = len >> 1;
+            size_t step = N / len; // Twiddle stride into the length-N table
+
+            for (size_t j = 0; j < half; ++j) {
+                float wRe, wIm;
+                twiddle(j * step, wRe, wIm);
+                if (inverse) {
+                    wIm = -wIm;
+                }
+
+                for (size_t i = j; i < HALF; i += len) {
+                    size_t a = 2 * i;
+                    size_t b = 2 * (i + half);
+
+                    float bRe = data[b] * wRe - data[b + 1] * wIm;
+                    float bIm = data[b] * wIm + data[b + 1] * wRe;
+
+                    data[b] = data[a] - bRe;
+                    data[b + 1] = data[a + 1] - bIm;
+                    data[a] += bRe;
+                    data[a + 1] += bIm;
+                }
+            }
+        }
+    }
+};
+
+} // namespace BassMINT
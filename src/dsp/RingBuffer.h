@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstring>
 #include <array>
+#include <atomic>
 
 namespace BassMINT {
 
@@ -14,6 +15,11 @@ namespace BassMINT {
  * - Consumer: Main loop (DSP processing)
  * - SIZE must be power of 2 for efficient masking
  *
+ * Besides per-sample push/pop, block producers use pushBlock() (memcpy in
+ * at most two pieces) and consumers can work in place: readSpans() returns
+ * the readable samples as up to two contiguous spans of the storage
+ * (before and after the wrap), consume() then releases them.
+ *
  * @tparam T Sample type (typically uint16_t or float)
  * @tparam SIZE Buffer size (must be power of 2)
  */
@@ -22,6 +28,21 @@ class RingBuffer {
     static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be power of 2");
 
 public:
+    /**
+     * @brief Readable samples as contiguous views into the storage
+     *
+     * first holds the oldest samples up to the end of the storage, second
+     * the remainder from the start (empty unless the data wraps).
+     */
+    struct Spans {
+        const T* first;
+        size_t firstSize;
+        const T* second;
+        size_t secondSize;
+
+        size_t size() const { return firstSize + secondSize; }
+    };
+
     RingBuffer() : writeIndex_(0), readIndex_(0) {
         // Zero-initialize buffer
         std::memset(buffer_.data(), 0, sizeof(buffer_));
@@ -45,6 +66,35 @@ public:
         return true;
     }
 
+    /**
+     * @brief Push a block of samples (ISR context, e.g. DMA block handoff)
+     *
+     * Copies with at most two memcpy calls. Samples that do not fit are
+     * dropped from the end of the block.
+     *
+     * @param samples Samples to push
+     * @param count Number of samples
+     * @return Number of samples pushed
+     */
+    size_t pushBlock(const T* samples, size_t count) {
+        size_t free = getFree();
+        size_t toPush = (count < free) ? count : free;
+
+        uint32_t write = writeIndex_;
+        size_t firstSize = SIZE - write;
+        if (firstSize > toPush) {
+            firstSize = toPush;
+        }
+
+        std::memcpy(&buffer_[write], samples, firstSize * sizeof(T));
+        std::memcpy(&buffer_[0], samples + firstSize, (toPush - firstSize) * sizeof(T));
+
+        // Samples must land before the consumer can see the new index
+        std::atomic_signal_fence(std::memory_order_release);
+        writeIndex_ = (write + toPush) & MASK;
+        return toPush;
+    }
+
     /**
      * @brief Pop a single sample (main loop context)
      * @param sample Output parameter for popped sample
@@ -96,6 +146,42 @@ public:
         return toRead;
     }
 
+    /**
+     * @brief View up to maxCount readable samples in place (main loop context)
+     *
+     * Nothing is removed until consume(); the spans stay valid until then
+     * because the producer never writes into unread samples.
+     *
+     * @param maxCount Upper bound on the samples returned
+     */
+    Spans readSpans(size_t maxCount) const {
+        size_t available = getAvailable();
+        size_t count = (maxCount < available) ? maxCount : available;
+
+        // Index first, then the samples it publishes
+        uint32_t read = readIndex_;
+        std::atomic_signal_fence(std::memory_order_acquire);
+
+        size_t firstSize = SIZE - read;
+        if (firstSize > count) {
+            firstSize = count;
+        }
+
+        return Spans{&buffer_[read], firstSize, &buffer_[0], count - firstSize};
+    }
+
+    /**
+     * @brief Release samples returned by readSpans() (main loop context)
+     * @param count Number of samples to drop, at most getAvailable()
+     */
+    void consume(size_t count) {
+        size_t available = getAvailable();
+        size_t toConsume = (count < available) ? count : available;
+
+        std::atomic_signal_fence(std::memory_order_release);
+        readIndex_ = (readIndex_ + toConsume) & MASK;
+    }
+
     /**
      * @brief Get number of samples available to read
      */
@@ -0,0 +1,32 @@
+#include "dsp/ScratchArena.h"
+
+namespace BassMINT {
+
+struct ScratchRegion {
+    unsigned char* storage;
+    const void* lastOwner;
+};
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+alignas(float) static unsigned char g_windowScratch[ScratchArena::WINDOW_BYTES];
+#endif
+alignas(float) static unsigned char g_detectorScratch[ScratchArena::DETECTOR_BYTES];
+
+static ScratchRegion g_regions[] = {
+#ifdef BASSMINT_FIXED_POINT_YIN
+    {nullptr, nullptr},           // Region::Window (unused)
+#else
+    {g_windowScratch, nullptr},   // Region::Window
+#endif
+    {g_detectorScratch, nullptr}, // Region::Detector
+};
+
+ScratchArena::Lease::Lease(Region region, const void* owner) {
+    ScratchRegion& scratch = g_regions[static_cast<size_t>(region)];
+
+    storage_ = scratch.storage;
+    preserved_ = (scratch.lastOwner == owner);
+    scratch.lastOwner = owner;
+}
+
+} // namespace BassMINT
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Static working memory shared by every string's pitch estimate
+ *
+ * The four StringProcessors run one after another on a single core (core1
+ * in the dual-core build), and the buffers a pitch estimate works in are
+ * only needed while that estimate runs. They live here once instead of
+ * once per string:
+ *
+ * - Window: float copy of the analysis window (StringProcessor)
+ * - Detector: per-lag arrays (YIN difference + CMNDF, MPM NSDF, or the
+ *   fixed-point YIN equivalents)
+ *
+ * Lifetime: a Lease borrows one region for the scope it is declared in,
+ * normally a single estimate() call. Leases of the same region must not
+ * overlap and must all be taken on the same core. Contents are garbage
+ * when a lease starts, unless isPreserved(): no other owner has leased
+ * the region since this owner's previous lease, so what it left there is
+ * still intact (lets a lone ringing string keep incremental state).
+ *
+ * Persistent per-string state (sample history, incremental YIN head,
+ * tracking) stays in the owning objects.
+ */
+class ScratchArena {
+public:
+    enum class Region : uint8_t {
+        Window,
+        Detector
+    };
+
+    // Region sizes in bytes (the fixed-point detector reads the raw
+    // history directly and needs no float window)
+    static constexpr size_t LAG_COUNT = PITCH_FRAME_SIZE / 2 + 1;
+#ifdef BASSMINT_FIXED_POINT_YIN
+    static constexpr size_t WINDOW_BYTES = 0;
+#else
+    static constexpr size_t WINDOW_BYTES = PITCH_FRAME_SIZE * sizeof(float);
+#endif
+    static constexpr size_t DETECTOR_BYTES = 2 * LAG_COUNT * sizeof(float);
+    static constexpr size_t TOTAL_BYTES = WINDOW_BYTES + DETECTOR_BYTES;
+
+    /**
+     * @brief Scoped access to one region
+     */
+    class Lease {
+    public:
+        /**
+         * @brief Borrow a region until the end of the enclosing scope
+         * @param region Region to borrow
+         * @param owner Identity of the borrower (usually 'this')
+         */
+        Lease(Region region, const void* owner);
+
+        Lease(const Lease&) = delete;
+        Lease& operator=(const Lease&) = delete;
+
+        /**
+         * @brief Region storage viewed as an array of T
+         * @param offset Offset in elements of T
+         */
+        template<typename T>
+        T* get(size_t offset = 0) const {
+            static_assert(alignof(T) <= alignof(float), "Region is float aligned");
+            return reinterpret_cast<T*>(storage_) + offset;
+        }
+
+        /**
+         * @brief Check if the region still holds this owner's previous data
+         */
+        bool isPreserved() const { return preserved_; }
+
+    private:
+        unsigned char* storage_;
+        bool preserved_;
+    };
+};
+
+} // namespace BassMINT
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief Single-producer single-consumer ring buffer safe across cores
+ *
+ * Same interface as RingBuffer, but the indices are std::atomic with
+ * acquire/release ordering instead of volatile, so the handoff stays
+ * correct when producer and consumer run on different RP2040 cores (or
+ * host threads). On the M0+ these compile to plain loads/stores plus DMB.
+ *
+ * - Free-running 32-bit indices: all SIZE slots are usable
+ * - Producer and consumer state each keep a cached copy of the other
+ *   side's index (on separate cache lines on the host); the shared index
+ *   is only re-read when the cached one says full (producer) or empty
+ *   (consumer)
+ * - Block calls (pushBlock, readSpans/consume, read) publish their index
+ *   once per block instead of once per sample
+ *
+ * Each method belongs to one side: push/pushBlock/getFree to the producer,
+ * everything else to the consumer.
+ *
+ * @tparam T Sample type (trivially copyable)
+ * @tparam SIZE Buffer size (must be power of 2)
+ */
+template<typename T, size_t SIZE>
+class SpscRingBuffer {
+    static_assert((SIZE & (SIZE - 1)) == 0, "SIZE must be power of 2");
+    static_assert(SIZE <= (1u << 31), "SIZE must fit the 32-bit index distance");
+
+public:
+    /**
+     * @brief Readable samples as contiguous views into the storage
+     *
+     * first holds the oldest samples up to the end of the storage, second
+     * the remainder from the start (empty unless the data wraps).
+     */
+    struct Spans {
+        const T* first;
+        size_t firstSize;
+        const T* second;
+        size_t secondSize;
+
+        size_t size() const { return firstSize + secondSize; }
+    };
+
+    SpscRingBuffer() {
+        buffer_.fill(T());
+    }
+
+    /**
+     * @brief Push a single sample (producer)
+     * @return true if pushed, false if buffer full
+     */
+    bool push(T sample) {
+        uint32_t write = writeIndex_.load(std::memory_order_relaxed);
+
+        if (write - cachedReadIndex_ == SIZE) {
+            cachedReadIndex_ = readIndex_.load(std::memory_order_acquire);
+            if (write - cachedReadIndex_ == SIZE) {
+                return false; // Buffer full
+            }
+        }
+
+        buffer_[write & MASK] = sample;
+        writeIndex_.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Push a block of samples (producer)
+     *
+     * Copies with at most two memcpy calls and publishes once. Samples that
+     * do not fit are dropped from the end of the block.
+     *
+     * @return Number of samples pushed
+     */
+    size_t pushBlock(const T* samples, size_t count) {
+        uint32_t write = writeIndex_.load(std::memory_order_relaxed);
+
+        size_t free = SIZE - (write - cachedReadIndex_);
+        if (free < count) {
+            cachedReadIndex_ = readIndex_.load(std::memory_order_acquire);
+            free = SIZE - (write - cachedReadIndex_);
+        }
+
+        size_t toPush = (count < free) ? count : free;
+        size_t offset = write & MASK;
+        size_t firstSize = SIZE - offset;
+        if (firstSize > toPush) {
+            firstSize = toPush;
+        }
+
+        std::memcpy(&buffer_[offset], samples, firstSize * sizeof(T));
+        std::memcpy(&buffer_[0], samples + firstSize, (toPush - firstSize) * sizeof(T));
+
+        writeIndex_.store(write + static_cast<uint32_t>(toPush), std::memory_order_release);
+        return toPush;
+    }
+
+    /**
+     * @brief Pop a single sample (consumer)
+     * @return true if popped, false if buffer empty
+     */
+    bool pop(T& sample) {
+        uint32_t read = readIndex_.load(std::memory_order_relaxed);
+
+        if (read == cachedWriteIndex_) {
+            cachedWriteIndex_ = writeIndex_.load(std::memory_order_acquire);
+            if (read == cachedWriteIndex_) {
+                return false; // Buffer empty
+            }
+        }
+
+        sample = buffer_[read & MASK];
+        readIndex_.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Read block of samples (consumer)
+     * @param output Output array (must have space for 'count')
+     * @return Actual number of samples read
+     */
+    size_t read(T* output, size_t count) {
+        Spans spans = readSpans(count);
+
+        std::memcpy(output, spans.first, spans.firstSize * sizeof(T));
+        std::memcpy(output + spans.firstSize, spans.second, spans.secondSize * sizeof(T));
+
+        consume(spans.size());
+        return spans.size();
+    }
+
+    /**
+     * @brief View up to maxCount readable samples in place (consumer)
+     *
+     * Nothing is removed until consume(); the spans stay valid until then
+     * because the producer never writes into unread samples.
+     */
+    Spans readSpans(size_t maxCount) {
+        uint32_t read = readIndex_.load(std::memory_order_relaxed);
+
+        size_t available = cachedWriteIndex_ - read;
+        if (available < maxCount) {
+            cachedWriteIndex_ = writeIndex_.load(std::memory_order_acquire);
+            available = cachedWriteIndex_ - read;
+        }
+
+        size_t count = (maxCount < available) ? maxCount : available;
+        size_t offset = read & MASK;
+        size_t firstSize = SIZE - offset;
+        if (firstSize > count) {
+            firstSize = count;
+        }
+
+        return Spans{&buffer_[offset], firstSize, &buffer_[0], count - firstSize};
+    }
+
+    /**
+     * @brief Release samples returned by readSpans() (consumer)
+     * @param count Number of samples to drop, at most the spans' size
+     */
+    void consume(size_t count) {
+        uint32_t read = readIndex_.load(std::memory_order_relaxed);
+        readIndex_.store(read + static_cast<uint32_t>(count), std::memory_order_release);
+    }
+
+    /**
+     * @brief Get number of samples available to read (consumer)
+     */
+    size_t getAvailable() const {
+        return writeIndex_.load(std::memory_order_acquire)
+             - readIndex_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Get free space for writing (producer)
+     */
+    size_t getFree() const {
+        return SIZE - (writeIndex_.load(std::memory_order_relaxed)
+                       - readIndex_.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Check if buffer is empty (consumer)
+     */
+    bool isEmpty() const {
+        return getAvailable() == 0;
+    }
+
+    /**
+     * @brief Drop everything currently readable (consumer)
+     */
+    void clear() {
+        cachedWriteIndex_ = writeIndex_.load(std::memory_order_acquire);
+        readIndex_.store(cachedWriteIndex_, std::memory_order_release);
+    }
+
+    /**
+     * @brief Get buffer capacity
+     */
+    static constexpr size_t capacity() { return SIZE; }
+
+private:
+    static constexpr uint32_t MASK = SIZE - 1;
+
+    // Keeps host threads (tests) from false sharing. Cortex-M has no data
+    // cache, so on the device padding the sides apart would only cost RAM
+    // (112 B per ring: one per string, the MIDI TX, report and event queues)
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+    static constexpr size_t SIDE_ALIGN = alignof(std::atomic<uint32_t>);
+#else
+    static constexpr size_t SIDE_ALIGN = 64;
+#endif
+
+    // Producer side
+    alignas(SIDE_ALIGN) std::atomic<uint32_t> writeIndex_{0};
+    uint32_t cachedReadIndex_ = 0;
+
+    // Consumer side
+    alignas(SIDE_ALIGN) std::atomic<uint32_t> readIndex_{0};
+    uint32_t cachedWriteIndex_ = 0;
+
+    alignas(SIDE_ALIGN > alignof(T) ? SIDE_ALIGN : alignof(T)) std::array<T, SIZE> buffer_;
+};
+
+} // namespace BassMINT
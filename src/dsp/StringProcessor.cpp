@@ -1,5 +1,6 @@
 #include "dsp/StringProcessor.h"
 #include <algorithm>
+#include <cstring>
 
 namespace BassMINT {
 
@@ -7,78 +8,233 @@ namespace BassMINT {
 static constexpr float ADC_MIDPOINT = 2048.0f;
 static constexpr float ADC_SCALE = 1.0f / 2048.0f;
 
-StringProcessor::StringProcessor(StringId stringId, float sampleRate)
+// Re-attack while the gate is still open: the envelope climbing this far
+// above its lowest point since the last peak is a new pluck
+static constexpr float REATTACK_RATIO = 1.5f;
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+static size_t windowPeriodsFor(PitchDetectorType type) {
+    return (type == PitchDetectorType::Mpm) ? PitchDetectorMpm::MPM_WINDOW_PERIODS
+                                            : AnalysisGeometry::MIN_WINDOW_PERIODS;
+}
+
+using FloatDetector = std::variant<PitchDetectorYin, PitchDetectorMpm>;
+
+static FloatDetector makeDetector(PitchDetectorType type, float sampleRate,
+                                  const AnalysisGeometry& geometry) {
+    if (type == PitchDetectorType::Mpm) {
+        return FloatDetector(std::in_place_type<PitchDetectorMpm>, sampleRate,
+                             geometry.windowSize, geometry.minFreq, geometry.maxFreq);
+    }
+
+    // Fft beats Incremental at the default 128-sample hop; switch to
+    // Incremental for hops of ~64 or less. Its d(tau) lives in the shared
+    // ScratchArena, so it only slides while a single string is active
+    return FloatDetector(std::in_place_type<PitchDetectorYin>, sampleRate,
+                         geometry.windowSize, geometry.minFreq, geometry.maxFreq,
+                         PitchDetectorYin::DifferenceMethod::Fft);
+}
+#endif
+
+StringProcessor::StringProcessor(StringId stringId, float sampleRate, size_t hopSize,
+                                 PitchDetectorType detectorType)
     : stringId_(stringId)
     , sampleRate_(sampleRate)
+    , hopSize_(std::clamp(hopSize, size_t(1), static_cast<size_t>(PITCH_FRAME_SIZE)))
+#ifdef BASSMINT_FIXED_POINT_YIN
+    , detectorType_(PitchDetectorType::Yin)
+    , geometry_(AnalysisGeometry::forString(stringId, sampleRate))
+#else
+    , detectorType_(detectorType)
+    , geometry_(AnalysisGeometry::forString(stringId, sampleRate, windowPeriodsFor(detectorType)))
+#endif
     , state_(StringState::Idle)
     , envelopeFollower_(sampleRate)
-    , pitchDetector_(sampleRate, PITCH_FRAME_SIZE)
+#ifdef BASSMINT_FIXED_POINT_YIN
+    , pitchDetector_(static_cast<uint32_t>(sampleRate), geometry_.windowSize,
+                     geometry_.minFreq, geometry_.maxFreq)
+#else
+    , pitchDetector_(makeDetector(detectorType, sampleRate, geometry_))
+#endif
     , wasActive_(false)
+    , envelopePeak_(0.0f)
+    , envelopeFloor_(0.0f)
+    , reattacks_(0)
+    , hopFill_(0)
+    , windowFill_(0)
+    , slidePending_(false)
+    , samplesSinceEstimate_(0)
 {
-    floatBuffer_.fill(0.0f);
     rawBuffer_.fill(0);
 
     // TODO: Tune envelope follower parameters per-string if needed
     // Different strings may have different optical characteristics
     envelopeFollower_.setThreshold(0.15f);  // Adjust based on testing
     envelopeFollower_.setHysteresis(0.6f);
-}
 
-bool StringProcessor::pushSample(uint16_t rawSample) {
-    // ISR context - must be fast!
-    return sampleBuffer_.push(rawSample);
+#ifdef BASSMINT_FIXED_POINT_YIN
+    (void)detectorType;
+#else
+    // Sustained notes only search a few semitones around the last pitch
+    if (auto* yin = std::get_if<PitchDetectorYin>(&pitchDetector_)) {
+        yin->setTrackingEnabled(true);
+    }
+#endif
 }
 
-void StringProcessor::process() {
+bool StringProcessor::process() {
     // Main loop context
 
-    // Read available samples from ring buffer
     size_t available = sampleBuffer_.getAvailable();
 
     if (available == 0) {
-        return; // Nothing to process
+        return false; // Nothing to process
     }
 
-    // Process samples in chunks up to frame size
-    size_t toProcess = std::min(available, static_cast<size_t>(PITCH_FRAME_SIZE));
+    // Consume whole hops only, so the window ends on a hop boundary when
+    // YIN runs. A trailing partial hop stays in the ring buffer; if no hop
+    // can complete yet, take everything to keep the envelope current.
+    size_t pending = hopFill_ + available;
+    size_t toConsume = (pending >= hopSize_)
+        ? (pending / hopSize_) * hopSize_ - hopFill_
+        : available;
 
-    // Read from ring buffer
-    size_t read = sampleBuffer_.read(rawBuffer_.data(), toProcess);
+    bool hopCompleted = false;
 
-    if (read == 0) {
-        return;
-    }
+    while (toConsume > 0) {
+        if (slidePending_) {
+            slideWindow();
+        }
+
+        // Newest hop occupies the tail of the analysis window
+        size_t offset = PITCH_FRAME_SIZE - hopSize_ + hopFill_;
+        size_t toRead = std::min(toConsume, hopSize_ - hopFill_);
+
+        // Convert in place from the ring storage, then release it
+        auto spans = sampleBuffer_.readSpans(toRead);
+        size_t read = spans.size();
+
+        if (read == 0) {
+            break;
+        }
+
+        appendSamples(spans.first, spans.firstSize, offset);
+        appendSamples(spans.second, spans.secondSize, offset + spans.firstSize);
+        sampleBuffer_.consume(read);
 
-    // Convert to float and update envelope
-    for (size_t i = 0; i < read; ++i) {
-        floatBuffer_[i] = normalizeAdcSample(rawBuffer_[i]);
-        envelopeFollower_.update(floatBuffer_[i]);
+        hopFill_ += read;
+        toConsume -= read;
+        samplesSinceEstimate_ = std::min(samplesSinceEstimate_ + read,
+                                         static_cast<size_t>(PITCH_FRAME_SIZE));
+
+        if (hopFill_ == hopSize_) {
+            hopFill_ = 0;
+            windowFill_ = std::min(windowFill_ + hopSize_, static_cast<size_t>(PITCH_FRAME_SIZE));
+            slidePending_ = true;
+            hopCompleted = true;
+        }
     }
 
     // Update state machine
     updateState();
 
-    // Run pitch detection if:
+    // Run pitch detection on the latest full window if:
     // - String is active
-    // - We have a full frame
-    if (isActive() && read >= PITCH_FRAME_SIZE) {
-        latestPitch_ = pitchDetector_.estimate(floatBuffer_.data(), PITCH_FRAME_SIZE);
+    // - A new hop just completed
+    // - The history holds a full analysis window of real samples
+    size_t windowSize = geometry_.windowSize;
+
+    if (isActive() && hopCompleted && windowFill_ >= windowSize) {
+#ifdef BASSMINT_FIXED_POINT_YIN
+        latestPitch_ = pitchDetector_.estimate(rawBuffer_.data() + PITCH_FRAME_SIZE - windowSize,
+                                               windowSize);
+#else
+        ScratchArena::Lease scratch(ScratchArena::Region::Window, this);
+        latestPitch_ = detector().estimate(prepareWindow(scratch), windowSize,
+                                           samplesSinceEstimate_);
+#endif
+        samplesSinceEstimate_ = 0;
 
         // Optionally reject low-confidence estimates
         if (latestPitch_.confidence < MIN_PITCH_CONFIDENCE) {
             latestPitch_ = PitchEstimate(); // Invalidate
         }
     }
+
+    return true;
+}
+
+StringReport StringProcessor::getReport(uint32_t timestampUs) const {
+    StringReport report;
+    report.string = stringId_;
+    report.state = state_;
+    report.pitch = latestPitch_;
+    report.envelope = envelopeFollower_.getEnvelope();
+    report.timestampUs = timestampUs;
+    return report;
 }
 
 void StringProcessor::reset() {
     sampleBuffer_.clear();
+    hopFill_ = 0;
+    windowFill_ = 0;
+    slidePending_ = false;
+    samplesSinceEstimate_ = 0;
+#ifndef BASSMINT_FIXED_POINT_YIN
+    detector().reset();
+#endif
     envelopeFollower_.reset();
     state_ = StringState::Idle;
     wasActive_ = false;
+    envelopePeak_ = 0.0f;
+    envelopeFloor_ = 0.0f;
     latestPitch_ = PitchEstimate();
 }
 
+#ifndef BASSMINT_FIXED_POINT_YIN
+PitchDetector& StringProcessor::detector() {
+    return std::visit([](auto& d) -> PitchDetector& { return d; }, pitchDetector_);
+}
+#endif
+
+void StringProcessor::slideWindow() {
+    // Drop the oldest hop; the tail is refilled from the ring buffer
+    size_t keep = PITCH_FRAME_SIZE - hopSize_;
+    std::memmove(rawBuffer_.data(), rawBuffer_.data() + hopSize_, keep * sizeof(uint16_t));
+    slidePending_ = false;
+}
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+const float* StringProcessor::prepareWindow(const ScratchArena::Lease& scratch) {
+    size_t windowSize = geometry_.windowSize;
+    const uint16_t* raw = rawBuffer_.data() + PITCH_FRAME_SIZE - windowSize;
+    float* window = scratch.get<float>();
+
+    // Our previous window is still there: shift it and convert only what
+    // arrived since (samplesSinceEstimate_ is exactly that advance)
+    size_t fresh = windowSize;
+    if (scratch.isPreserved() && samplesSinceEstimate_ < windowSize) {
+        fresh = samplesSinceEstimate_;
+        std::memmove(window, window + fresh, (windowSize - fresh) * sizeof(float));
+    }
+
+    for (size_t i = windowSize - fresh; i < windowSize; ++i) {
+        window[i] = normalizeAdcSample(raw[i]);
+    }
+
+    return window;
+}
+#endif
+
+void StringProcessor::appendSamples(const uint16_t* rawSamples, size_t count, size_t offset) {
+    std::memcpy(rawBuffer_.data() + offset, rawSamples, count * sizeof(uint16_t));
+
+    // Envelope runs on every sample as it arrives
+    for (size_t i = 0; i < count; ++i) {
+        envelopeFollower_.update(normalizeAdcSample(rawSamples[i]));
+    }
+}
+
 float StringProcessor::normalizeAdcSample(uint16_t raw) const {
     // Remove DC bias and normalize to [-1.0, 1.0]
     // OPT101 output is biased around Vcc/2, so ADC reads ~2048 at rest
@@ -88,11 +244,17 @@ float StringProcessor::normalizeAdcSample(uint16_t raw) const {
 
 void StringProcessor::updateState() {
     bool currentlyActive = envelopeFollower_.isActive();
+    float envelope = envelopeFollower_.getEnvelope();
 
     // State transitions
     if (!wasActive_ && currentlyActive) {
         // Idle -> Attack
         state_ = StringState::Attack;
+        envelopePeak_ = envelope;
+        envelopeFloor_ = envelope;
+#ifndef BASSMINT_FIXED_POINT_YIN
+        detector().clearTrackingHint(); // New pluck, new pitch
+#endif
     } else if (wasActive_ && !currentlyActive) {
         // Active -> Release
         state_ = StringState::Release;
@@ -101,6 +263,7 @@ void StringProcessor::updateState() {
         if (state_ == StringState::Attack) {
             state_ = StringState::Active;
         }
+        trackReattack(envelope);
     } else {
         // Release -> Idle
         if (state_ == StringState::Release) {
@@ -112,4 +275,28 @@ void StringProcessor::updateState() {
     wasActive_ = currentlyActive;
 }
 
+void StringProcessor::trackReattack(float envelope) {
+    // Re-plucked before the gate closed (the envelope had decayed and
+    // climbs again): the tracker must not keep the old note's lag, which
+    // could lock in an octave off until its next refresh
+    bool decayed = envelopeFloor_ < envelopePeak_;
+    if (decayed && envelope > envelopeFloor_ * REATTACK_RATIO) {
+        envelopePeak_ = envelope;
+        envelopeFloor_ = envelope;
+        reattacks_++;
+#ifndef BASSMINT_FIXED_POINT_YIN
+        detector().clearTrackingHint();
+#endif
+        return;
+    }
+
+    if (envelope >= envelopePeak_) {
+        // Still rising
+        envelopePeak_ = envelope;
+        envelopeFloor_ = envelope;
+    } else {
+        envelopeFloor_ = std::min(envelopeFloor_, envelope);
+    }
+}
+
 } // namespace BassMINT
@@ -1,10 +1,16 @@
 #pragma once
 
 #include "core/Types.h"
-#include "dsp/RingBuffer.h"
+#include "dsp/AnalysisGeometry.h"
+#include "dsp/SpscRingBuffer.h"
 #include "dsp/EnvelopeFollower.h"
+#include "dsp/PitchDetector.h"
+#include "dsp/PitchDetectorMpm.h"
 #include "dsp/PitchDetectorYin.h"
+#include "dsp/PitchDetectorYinFixed.h"
+#include "dsp/ScratchArena.h"
 #include <array>
+#include <variant>
 
 namespace BassMINT {
 
@@ -14,7 +20,29 @@ namespace BassMINT {
  * Combines:
  * - Ring buffer (receives samples from ADC ISR)
  * - Envelope follower (detects string activity)
- * - YIN pitch detector (estimates fundamental frequency)
+ * - Pitch detector (estimates fundamental frequency): YIN or MPM, chosen
+ *   per string by PitchDetectorType
+ *
+ * Samples are copied straight out of the ISR ring buffer's storage
+ * (SpscRingBuffer::readSpans) into a sliding raw history of
+ * PITCH_FRAME_SIZE samples, separate from the ring buffer, and feed the
+ * envelope as they arrive. YIN runs on the latest full window every
+ * hopSize samples, so pitch updates arrive every hop (16 ms at 128) while
+ * the window stays 128 ms. The normalized float window it reads is built
+ * in the shared ScratchArena just before each estimate; when no other
+ * string used the arena since, only the samples of the new hops are
+ * converted.
+ *
+ * Lag range and window length come from the string's AnalysisGeometry:
+ * YIN analyzes only the newest geometry.windowSize samples of the
+ * history (384 for G up to 896 for E @ 8 kHz). MPM needs fewer periods
+ * (PitchDetectorMpm::MPM_WINDOW_PERIODS), so its windows are shorter.
+ *
+ * With BASSMINT_FIXED_POINT_YIN defined, pitch detection runs the integer
+ * PitchDetectorYinFixed directly on the raw 12-bit samples instead.
+ *
+ * The ring buffer is the only state shared with the producer, so
+ * pushSample()/pushBlock() may run on the other core (BASSMINT_DUAL_CORE).
  *
  * Designed to be instantiated once per string (4 instances total).
  */
@@ -24,21 +52,42 @@ public:
      * @brief Constructor
      * @param stringId Which string this processor handles
      * @param sampleRate Sample rate in Hz
+     * @param hopSize Samples between pitch estimates (1 .. PITCH_FRAME_SIZE)
+     * @param detectorType Pitch detection algorithm (ignored with
+     *                     BASSMINT_FIXED_POINT_YIN)
      */
-    explicit StringProcessor(StringId stringId, float sampleRate = SAMPLE_RATE_HZ);
+    explicit StringProcessor(StringId stringId,
+                             float sampleRate = SAMPLE_RATE_HZ,
+                             size_t hopSize = PITCH_HOP_SIZE,
+                             PitchDetectorType detectorType = PitchDetectorType::Yin);
 
     /**
      * @brief Push new ADC sample (called from ISR context)
      * @param rawSample 12-bit ADC value (0-4095)
      * @return true if sample accepted, false if buffer full
      */
-    bool pushSample(uint16_t rawSample);
+    bool pushSample(uint16_t rawSample) {
+        // ISR context - must be fast!
+        return sampleBuffer_.push(rawSample);
+    }
 
     /**
-     * @brief Process available samples (main loop context)
+     * @brief Push a block of ADC samples (called from ISR context)
+     * @param rawSamples 12-bit ADC values, oldest first
+     * @param count Number of samples
+     * @return Number of samples accepted (the rest are dropped)
+     */
+    size_t pushBlock(const uint16_t* rawSamples, size_t count) {
+        // ISR context - memcpy into the ring buffer
+        return sampleBuffer_.pushBlock(rawSamples, count);
+    }
+
+    /**
+     * @brief Process available samples (main loop / DSP core context)
      * Updates envelope follower and runs pitch detection if enough samples available
+     * @return true if any samples were consumed (state or pitch may have changed)
      */
-    void process();
+    bool process();
 
     /**
      * @brief Get current string state
@@ -58,6 +107,12 @@ public:
      */
     const PitchEstimate& getLatestPitch() const { return latestPitch_; }
 
+    /**
+     * @brief Snapshot of state and pitch for StringManager
+     * @param timestampUs Time the snapshot was taken
+     */
+    StringReport getReport(uint32_t timestampUs = 0) const;
+
     /**
      * @brief Get string ID
      */
@@ -75,27 +130,100 @@ public:
 
     /**
      * @brief Get current envelope value (for debugging/plotting)
+     *
+     * DSP context only; other cores read StringReport::envelope.
      */
     float getEnvelope() const { return envelopeFollower_.getEnvelope(); }
 
+    /**
+     * @brief Re-plucks detected while the string was still active
+     */
+    uint32_t getReattacks() const { return reattacks_; }
+
+    /**
+     * @brief Get per-string analysis geometry (lag bounds, window length)
+     */
+    const AnalysisGeometry& getGeometry() const { return geometry_; }
+
+    /**
+     * @brief Get hop size (samples between pitch estimates)
+     */
+    size_t getHopSize() const { return hopSize_; }
+
+    /**
+     * @brief Get pitch detection algorithm in use
+     */
+    PitchDetectorType getDetectorType() const { return detectorType_; }
+
 private:
     StringId stringId_;
     float sampleRate_;
+    size_t hopSize_;
+    PitchDetectorType detectorType_;
+    AnalysisGeometry geometry_;
     StringState state_;
 
     // DSP components
-    RingBuffer<uint16_t, RING_BUFFER_SIZE> sampleBuffer_;
+    SpscRingBuffer<uint16_t, RING_BUFFER_SIZE> sampleBuffer_;
     EnvelopeFollower envelopeFollower_;
-    PitchDetectorYin pitchDetector_;
-
-    // Working buffers
-    std::array<float, PITCH_FRAME_SIZE> floatBuffer_;
+#ifdef BASSMINT_FIXED_POINT_YIN
+    PitchDetectorYinFixed pitchDetector_;
+#else
+    // Only the selected detector is constructed; accessed via detector().
+    // The slot is sized for the larger alternative (YIN), so a string
+    // that selects MPM saves construction, not RAM
+    std::variant<PitchDetectorYin, PitchDetectorMpm> pitchDetector_;
+#endif
+
+    // Sliding raw history (oldest sample first, newest hop at the tail);
+    // the analysis window is its last geometry_.windowSize samples
     std::array<uint16_t, PITCH_FRAME_SIZE> rawBuffer_;
 
     // State tracking
     PitchEstimate latestPitch_;
     bool wasActive_;
 
+    // Re-attack detection while active: envelope peak and the lowest
+    // value since it
+    float envelopePeak_;
+    float envelopeFloor_;
+    uint32_t reattacks_;
+
+    // Sliding window tracking
+    size_t hopFill_;     // Samples written into the current hop
+    size_t windowFill_;  // Valid samples in the history (saturates at PITCH_FRAME_SIZE)
+    bool slidePending_;  // Window must shift by one hop before the next write
+    size_t samplesSinceEstimate_; // Window advance since the last YIN run
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+    /**
+     * @brief The selected float pitch detector
+     */
+    PitchDetector& detector();
+#endif
+
+    /**
+     * @brief Shift the analysis window left by one hop
+     */
+    void slideWindow();
+
+#ifndef BASSMINT_FIXED_POINT_YIN
+    /**
+     * @brief Normalized float copy of the analysis window
+     * @param scratch Lease on the ScratchArena Window region
+     * @return Window of geometry_.windowSize samples inside the lease
+     */
+    const float* prepareWindow(const ScratchArena::Lease& scratch);
+#endif
+
+    /**
+     * @brief Append raw samples to the window tail and update the envelope
+     * @param rawSamples Samples in ring buffer storage
+     * @param count Number of samples
+     * @param offset Window index of the first sample
+     */
+    void appendSamples(const uint16_t* rawSamples, size_t count, size_t offset);
+
     /**
      * @brief Convert raw ADC sample to normalized float
      * @param raw 12-bit ADC value (0-4095)
@@ -107,6 +235,12 @@ private:
      * @brief Update state machine based on envelope
      */
     void updateState();
+
+    /**
+     * @brief Detect a re-pluck while active and drop the tracking hint
+     * @param envelope Current envelope value
+     */
+    void trackReattack(float envelope);
 };
 
 } // namespace BassMINT
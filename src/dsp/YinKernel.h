@@ -0,0 +1,335 @@
+#pragma once
+
+#include "core/Types.h"
+#include "dsp/AnalysisGeometry.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief YIN building blocks shared by the runtime and compile-time detectors
+ *
+ * Every step takes its frame size and lag bounds as arguments and is
+ * inline, so a caller that passes compile-time constants (StaticYinKernel,
+ * StaticPitchDetectorYin) gets loops with constant trip counts and constant
+ * strides, while PitchDetectorYin calls the very same code with its
+ * runtime members. One implementation, two instantiations.
+ */
+struct YinKernel {
+    /**
+     * @brief Difference function at a single lag
+     * @param samples Input frame (length = frameSize)
+     */
+    static inline float lagDifference(const float* samples, size_t frameSize, size_t tau) {
+        const float* lagged = samples + tau;
+        float sum = 0.0f;
+        for (size_t j = 0; j < frameSize - tau; ++j) {
+            float delta = samples[j] - lagged[j];
+            sum += delta * delta;
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Brute-force difference function d(tau), tau = 0 .. maxLag-1
+     * @param samples Input frame (length = frameSize)
+     * @param difference Output, at least maxLag entries
+     */
+    static inline void difference(const float* samples, float* difference,
+                                  size_t frameSize, size_t maxLag) {
+        // YIN difference function: d(tau) = sum((samples[j] - samples[j+tau])^2)
+        for (size_t tau = 0; tau < maxLag; ++tau) {
+            difference[tau] = lagDifference(samples, frameSize, tau);
+        }
+    }
+
+    /**
+     * @brief Frame energy sum(x[j]^2)
+     */
+    static inline float energy(const float* samples, size_t frameSize) {
+        float sum = 0.0f;
+        for (size_t j = 0; j < frameSize; ++j) {
+            sum += samples[j] * samples[j];
+        }
+        return sum;
+    }
+
+    /**
+     * @brief Energy-normalized difference over a narrow lag range
+     *
+     * normalized[k] = d(tau) / (e_head(tau) + e_tail(tau)), tau = first + k,
+     * where d(tau) = e_head(tau) + e_tail(tau) - 2 * acf(tau). 0 means
+     * perfectly periodic at tau, ~1 uncorrelated. Unlike the CMNDF it needs
+     * no shorter lags, so a few lags around a known period cost a few
+     * lagDifference() calls.
+     *
+     * @param energy Frame energy (see energy())
+     * @param normalized Output, last - first + 1 entries
+     */
+    static inline void normalizedDifference(const float* samples, size_t frameSize, float energy,
+                                            size_t first, size_t last, float* normalized) {
+        // Walk the energy terms down to the first lag
+        float headEnergy = energy;
+        float tailEnergy = energy;
+
+        for (size_t tau = 0; tau <= last; ++tau) {
+            if (tau >= first) {
+                float d = lagDifference(samples, frameSize, tau);
+                float energySum = headEnergy + tailEnergy;
+                normalized[tau - first] = (energySum > 0.0f) ? d / energySum : 1.0f;
+            }
+
+            float leavingHead = samples[frameSize - 1 - tau];
+            float leavingTail = samples[tau];
+            headEnergy -= leavingHead * leavingHead;
+            tailEnergy -= leavingTail * leavingTail;
+        }
+    }
+
+    /**
+     * @brief Cumulative mean normalized difference, tau = 0 .. maxLag-1
+     */
+    static inline void cmndf(const float* difference, float* cmndf, size_t maxLag) {
+        // cmndf(0) = 1 by definition
+        cmndf[0] = 1.0f;
+
+        float runningSum = 0.0f;
+
+        for (size_t tau = 1; tau < maxLag; ++tau) {
+            runningSum += difference[tau];
+
+            if (runningSum == 0.0f) {
+                cmndf[tau] = 1.0f; // Avoid division by zero
+            } else {
+                cmndf[tau] = difference[tau] / (runningSum / static_cast<float>(tau));
+            }
+        }
+    }
+
+    /**
+     * @brief Find absolute threshold minimum in CMNDF
+     * @return Lag of minimum, or 0 if none found
+     */
+    static inline size_t absoluteThreshold(const float* cmndf, float threshold,
+                                           size_t minLag, size_t maxLag) {
+        // Find first local minimum below threshold in valid lag range
+        for (size_t tau = minLag; tau < maxLag - 1; ++tau) {
+            if (cmndf[tau] < threshold) {
+                // Check if local minimum (value less than neighbors)
+                if (cmndf[tau] < cmndf[tau + 1]) {
+                    return tau;
+                }
+            }
+        }
+
+        // If no threshold crossing, find global minimum
+        return globalMinimum(cmndf, minLag, maxLag);
+    }
+
+    /**
+     * @brief Fallback when nothing crosses the threshold
+     * @return Lag of the global CMNDF minimum if it is below 0.5, else 0
+     */
+    static inline size_t globalMinimum(const float* cmndf, size_t minLag, size_t maxLag) {
+        size_t minIdx = minLag;
+        float minVal = cmndf[minLag];
+
+        for (size_t tau = minLag + 1; tau < maxLag; ++tau) {
+            if (cmndf[tau] < minVal) {
+                minVal = cmndf[tau];
+                minIdx = tau;
+            }
+        }
+
+        // Only return if confidence is reasonable
+        if (minVal < 0.5f) {
+            return minIdx;
+        }
+
+        return 0; // No valid pitch
+    }
+
+    /**
+     * @brief Difference, CMNDF and threshold in one pass over tau
+     *
+     * Computes d(tau) and cmndf(tau) lag by lag and stops one lag after the
+     * first local minimum below the threshold, so a high note never pays for
+     * the long lags. Returns exactly what difference() + cmndf() +
+     * absoluteThreshold() would; entries past the returned lag + 1 are left
+     * stale unless the search falls back to the global minimum.
+     *
+     * @return Lag of minimum, or 0 if none found
+     */
+    static inline size_t fusedSearch(const float* samples, float* difference, float* cmndf,
+                                     float threshold, size_t frameSize,
+                                     size_t minLag, size_t maxLag) {
+        difference[0] = 0.0f;
+        cmndf[0] = 1.0f;
+
+        float runningSum = 0.0f;
+        bool belowThreshold = false; // cmndf[tau - 1] is a threshold candidate
+
+        for (size_t tau = 1; tau < maxLag; ++tau) {
+            float d = lagDifference(samples, frameSize, tau);
+            difference[tau] = d;
+            runningSum += d;
+
+            if (runningSum == 0.0f) {
+                cmndf[tau] = 1.0f; // Avoid division by zero
+            } else {
+                cmndf[tau] = d / (runningSum / static_cast<float>(tau));
+            }
+
+            // Previous lag dipped below threshold: it is the minimum if this one rises
+            if (belowThreshold && cmndf[tau - 1] < cmndf[tau]) {
+                return tau - 1;
+            }
+
+            belowThreshold = tau >= minLag
+                          && tau < maxLag - 1
+                          && cmndf[tau] < threshold;
+        }
+
+        return globalMinimum(cmndf, minLag, maxLag);
+    }
+
+    /**
+     * @brief Parabolic interpolation for sub-sample accuracy
+     * @return Refined lag with fractional part
+     */
+    static inline float parabolicInterpolation(const float* cmndf, size_t tau, size_t maxLag) {
+        if (tau < 1 || tau >= maxLag - 1) {
+            return static_cast<float>(tau); // Can't interpolate at boundaries
+        }
+
+        float s0 = cmndf[tau - 1];
+        float s1 = cmndf[tau];
+        float s2 = cmndf[tau + 1];
+
+        // Find vertex of parabola through three points
+        float adjustment = (s2 - s0) / (2.0f * (2.0f * s1 - s2 - s0));
+
+        return static_cast<float>(tau) + adjustment;
+    }
+};
+
+/**
+ * @brief YinKernel with the frame size and lag range fixed at compile time
+ *
+ * The static functions are plain function pointers, which is how
+ * PitchDetectorYin picks a specialized loop for a matching geometry.
+ */
+template<size_t FrameSize, size_t MinLag, size_t MaxLag>
+struct StaticYinKernel {
+    static_assert(MinLag >= 1 && MinLag + 1 < MaxLag, "Lag range too narrow");
+    static_assert(MaxLag <= FrameSize / 2, "YIN needs maxLag <= frameSize / 2");
+
+    static constexpr size_t FRAME_SIZE = FrameSize;
+    static constexpr size_t MIN_LAG = MinLag;
+    static constexpr size_t MAX_LAG = MaxLag;
+
+    static void difference(const float* samples, float* difference) {
+        YinKernel::difference(samples, difference, FrameSize, MaxLag);
+    }
+
+    static void cmndf(const float* difference, float* cmndf) {
+        YinKernel::cmndf(difference, cmndf, MaxLag);
+    }
+
+    static size_t absoluteThreshold(const float* cmndf, float threshold) {
+        return YinKernel::absoluteThreshold(cmndf, threshold, MinLag, MaxLag);
+    }
+
+    static size_t fusedSearch(const float* samples, float* difference, float* cmndf,
+                              float threshold) {
+        return YinKernel::fusedSearch(samples, difference, cmndf, threshold,
+                                      FrameSize, MinLag, MaxLag);
+    }
+};
+
+/**
+ * @brief Direct YIN detector with exactly sized working arrays
+ *
+ * Compile-time twin of PitchDetectorYin (Direct method): 2 * MaxLag floats
+ * of state instead of the runtime class's worst-case arrays, and every
+ * loop bound is a constant. Use StringPitchDetectorYin<S> to get the
+ * variant matching a string's AnalysisGeometry.
+ */
+template<size_t FrameSize, size_t MinLag, size_t MaxLag>
+class StaticPitchDetectorYin {
+public:
+    using Kernel = StaticYinKernel<FrameSize, MinLag, MaxLag>;
+
+    static constexpr size_t FRAME_SIZE = FrameSize;
+
+    /**
+     * @brief Constructor
+     * @param sampleRate Sample rate in Hz (only used to convert lag to Hz)
+     */
+    explicit StaticPitchDetectorYin(float sampleRate = SAMPLE_RATE_HZ)
+        : sampleRate_(sampleRate)
+        , confidenceThreshold_(0.15f) // YIN default threshold
+    {
+        differenceFunction_.fill(0.0f);
+        cmndf_.fill(0.0f);
+    }
+
+    /**
+     * @brief Estimate pitch from a FrameSize-sample window
+     * @param samples Input audio samples (length = FrameSize)
+     * @return Pitch estimate with frequency and confidence
+     */
+    PitchEstimate estimate(const float* samples) {
+        if (!samples) {
+            return PitchEstimate(); // Invalid input
+        }
+
+        Kernel::difference(samples, differenceFunction_.data());
+        Kernel::cmndf(differenceFunction_.data(), cmndf_.data());
+
+        size_t tau = Kernel::absoluteThreshold(cmndf_.data(), confidenceThreshold_);
+        if (tau == 0) {
+            return PitchEstimate(); // No pitch detected
+        }
+
+        float refinedTau = YinKernel::parabolicInterpolation(cmndf_.data(), tau, MaxLag);
+
+        return PitchEstimate(sampleRate_ / refinedTau, 1.0f - cmndf_[tau]);
+    }
+
+    /**
+     * @brief Set confidence threshold for valid pitch
+     * @param threshold Minimum confidence (0.0-1.0)
+     */
+    void setConfidenceThreshold(float threshold) {
+        confidenceThreshold_ = threshold;
+    }
+
+    /**
+     * @brief Get current confidence threshold
+     */
+    float getConfidenceThreshold() const {
+        return confidenceThreshold_;
+    }
+
+private:
+    float sampleRate_;
+    float confidenceThreshold_;
+
+    // Working buffers, sized exactly for the lag range
+    std::array<float, MaxLag> differenceFunction_;
+    std::array<float, MaxLag> cmndf_;
+};
+
+/**
+ * @brief StaticPitchDetectorYin for one string's AnalysisGeometry at SAMPLE_RATE_HZ
+ */
+template<StringId S>
+using StringPitchDetectorYin = StaticPitchDetectorYin<
+    AnalysisGeometry::forString(S).windowSize,
+    AnalysisGeometry::forString(S).minLag,
+    AnalysisGeometry::forString(S).maxLag>;
+
+} // namespace BassMINT
@@ -0,0 +1,111 @@
+#pragma once
+
+#include "core/Types.h"
+#include <cstddef>
+#include <cstdint>
+#include <array>
+
+namespace BassMINT {
+
+/**
+ * @brief Ping-pong block bookkeeping for DMA ADC capture
+ *
+ * Owns the two capture buffers and tracks which one the hardware fills
+ * next. AdcDriver points two chained DMA channels at getBuffer(0) and
+ * getBuffer(1); when channel i finishes, the IRQ handler calls complete(i)
+ * and hands the returned block to the consumer while the other channel is
+ * already filling its buffer.
+ *
+ * Blocks are interleaved in ADC round-robin order: frame k is
+ * block[k * Channels + c] for channel c = 0 .. Channels-1.
+ *
+ * No hardware access, so the handoff logic does not depend on the Pico SDK.
+ *
+ * @tparam BlockFrames Frames (one sample per channel) per block
+ * @tparam Channels Interleaved channels per frame
+ */
+template<size_t BlockFrames, size_t Channels = NUM_STRINGS>
+class AdcBlockHandoff {
+public:
+    static constexpr size_t BLOCK_FRAMES = BlockFrames;
+    static constexpr size_t CHANNELS = Channels;
+    static constexpr size_t BLOCK_SAMPLES = BlockFrames * Channels;
+    static constexpr size_t NUM_BUFFERS = 2;
+
+    static_assert(BlockFrames > 0, "Block must hold at least one frame");
+
+    /**
+     * @brief Capture buffer for DMA channel index (0 or 1)
+     */
+    uint16_t* getBuffer(size_t index) {
+        return buffers_[index % NUM_BUFFERS].data();
+    }
+
+    /**
+     * @brief Buffer the hardware is expected to complete next
+     */
+    size_t getExpected() const { return expected_; }
+
+    /**
+     * @brief Mark buffer index as filled (DMA completion, ISR context)
+     *
+     * Completions must alternate 0, 1, 0, ... A completion out of turn means
+     * the other buffer's interrupt was never serviced and its block was
+     * lost; it is counted in getDroppedBlocks() and the sequence resyncs.
+     *
+     * @return The completed block (BLOCK_SAMPLES interleaved samples)
+     */
+    const uint16_t* complete(size_t index) {
+        index %= NUM_BUFFERS;
+
+        if (index != expected_) {
+            droppedBlocks_++;
+        }
+
+        expected_ = (index + 1) % NUM_BUFFERS;
+        completedBlocks_++;
+
+        return buffers_[index].data();
+    }
+
+    /**
+     * @brief Restart the sequence at buffer 0 (capture restart)
+     */
+    void reset() {
+        expected_ = 0;
+    }
+
+    /**
+     * @brief Blocks handed to the consumer since construction
+     */
+    uint32_t getCompletedBlocks() const { return completedBlocks_; }
+
+    /**
+     * @brief Blocks skipped because a completion was missed
+     */
+    uint32_t getDroppedBlocks() const { return droppedBlocks_; }
+
+    /**
+     * @brief Copy one channel out of an interleaved block
+     * @param block Interleaved samples (frames * Channels)
+     * @param frames Number of frames in block
+     * @param channel Channel to extract (0 .. Channels-1)
+     * @param output Destination, frames entries, oldest first
+     */
+    static void extractChannel(const uint16_t* block, size_t frames, size_t channel,
+                               uint16_t* output) {
+        const uint16_t* sample = block + channel;
+        for (size_t frame = 0; frame < frames; ++frame) {
+            output[frame] = *sample;
+            sample += Channels;
+        }
+    }
+
+private:
+    std::array<std::array<uint16_t, BLOCK_SAMPLES>, NUM_BUFFERS> buffers_{};
+    size_t expected_ = 0;
+    uint32_t completedBlocks_ = 0;
+    uint32_t droppedBlocks_ = 0;
+};
+
+} // namespace BassMINT
@@ -1,7 +1,9 @@
 #include "hal/AdcDriver.h"
 #include "hal/BoardConfig.h"
 #include "hardware/adc.h"
+#include "hardware/dma.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
 #include "pico/time.h"
 
 namespace BassMINT {
@@ -10,14 +12,24 @@ namespace BassMINT {
 static constexpr float ADC_VREF = 3.3f;
 static constexpr float ADC_MAX_VALUE = 4095.0f; // 12-bit ADC
 
-// Global instance pointer for ISR callback
-static AdcDriver* g_adcDriverInstance = nullptr;
+// Round-robin over ADC0-3 (one bit per input)
+static constexpr uint32_t ADC_ROUND_ROBIN_MASK = (1u << NUM_STRINGS) - 1;
 
-void AdcDriver::init() {
+// Free-running pacing: one conversion every (1 + div) ADC clocks.
+// 48 MHz / (32 kHz aggregate * 4x oversampling) = 375 clocks per conversion
+static constexpr float ADC_CLKDIV =
+    static_cast<float>(BoardConfig::ADC_CLOCK_HZ) /
+    static_cast<float>(ADC_AGGREGATE_RATE_HZ * BoardConfig::ADC_OVERSAMPLING) - 1.0f;
+
+static_assert(ADC_CLKDIV >= 95.0f, "Aggregate rate exceeds 500 ksps ADC limit");
+
+void AdcDriverBase::init(AdcCaptureMode mode) {
     if (initialized_) {
         return;
     }
 
+    mode_ = mode;
+
     // Initialize ADC hardware
     adc_init();
 
@@ -26,45 +38,55 @@ void AdcDriver::init() {
         adc_gpio_init(BoardConfig::ADC_PINS[i]);
     }
 
-    // Set global instance for ISR
-    g_adcDriverInstance = this;
+    if (mode_ == AdcCaptureMode::Dma) {
+        for (int& channel : dmaChannels_) {
+            channel = dma_claim_unused_channel(true);
+        }
+    }
 
     initialized_ = true;
 }
 
-void AdcDriver::setSampleCallback(SampleCallback callback) {
-    sampleCallback_ = callback;
-}
-
-void AdcDriver::startSampling() {
+void AdcDriverBase::startSampling(repeating_timer_callback_t timerCallback,
+                                  void (*dmaHandler)()) {
     if (!initialized_ || sampling_) {
         return;
     }
 
+    if (mode_ == AdcCaptureMode::Dma) {
+        startDmaCapture(dmaHandler);
+        sampling_ = true;
+        return;
+    }
+
     // Start repeating timer at configured interval
     // Negative interval means interval is in microseconds
     add_repeating_timer_us(
         -static_cast<int32_t>(BoardConfig::ADC_TIMER_INTERVAL_US),
         timerCallback,
-        nullptr,
+        this,
         &timer_
     );
 
     sampling_ = true;
 }
 
-void AdcDriver::stopSampling() {
+void AdcDriverBase::stopSampling() {
     if (!sampling_) {
         return;
     }
 
-    cancel_repeating_timer(&timer_);
+    if (mode_ == AdcCaptureMode::Dma) {
+        stopDmaCapture();
+    } else {
+        cancel_repeating_timer(&timer_);
+    }
     sampling_ = false;
 }
 
-uint16_t AdcDriver::readSingle(StringId string) {
-    if (!initialized_) {
-        return 0;
+uint16_t AdcDriverBase::readSingle(StringId string) {
+    if (!initialized_ || (sampling_ && mode_ == AdcCaptureMode::Dma)) {
+        return 0; // ADC is free-running into the FIFO
     }
 
     uint8_t channel = static_cast<uint8_t>(string);
@@ -79,36 +101,108 @@ uint16_t AdcDriver::readSingle(StringId string) {
     return adc_read();
 }
 
-float AdcDriver::rawToVoltage(uint16_t raw) {
+float AdcDriverBase::rawToVoltage(uint16_t raw) {
     return (static_cast<float>(raw) / ADC_MAX_VALUE) * ADC_VREF;
 }
 
-bool AdcDriver::timerCallback(struct repeating_timer* t) {
-    (void)t; // Unused
-    if (g_adcDriverInstance) {
-        return g_adcDriverInstance->onTimerFired();
+void AdcDriverBase::startDmaCapture(void (*dmaHandler)()) {
+    handoff_.reset();
+    for (Decimator& decimator : decimators_) {
+        decimator.reset();
     }
-    return true; // Continue timer
+
+    // Free-running round-robin conversions into the FIFO, starting at ADC0
+    adc_select_input(0);
+    adc_set_round_robin(ADC_ROUND_ROBIN_MASK);
+    adc_fifo_setup(
+        true,   // Write conversions to the FIFO
+        true,   // Raise DREQ when a sample is available
+        1,      // DREQ threshold: every sample
+        false,  // No error bit (keep samples 12-bit clean)
+        false   // No byte shift (DMA moves 16-bit samples)
+    );
+    adc_set_clkdiv(ADC_CLKDIV);
+    adc_fifo_drain();
+
+    // Two channels, each filling its own buffer and then triggering the
+    // other: capture continues while the finished block is handed off
+    for (size_t i = 0; i < BlockHandoff::NUM_BUFFERS; ++i) {
+        uint channel = static_cast<uint>(dmaChannels_[i]);
+        uint next = static_cast<uint>(dmaChannels_[(i + 1) % BlockHandoff::NUM_BUFFERS]);
+
+        dma_channel_config config = dma_channel_get_default_config(channel);
+        channel_config_set_transfer_data_size(&config, DMA_SIZE_16);
+        channel_config_set_read_increment(&config, false);
+        channel_config_set_write_increment(&config, true);
+        channel_config_set_dreq(&config, DREQ_ADC);
+        channel_config_set_chain_to(&config, next);
+
+        dma_channel_configure(channel, &config,
+                              handoff_.getBuffer(i),
+                              &adc_hw->fifo,
+                              BlockHandoff::BLOCK_SAMPLES,
+                              false);
+
+        dma_channel_set_irq0_enabled(channel, true);
+    }
+
+    irq_set_exclusive_handler(DMA_IRQ_0, dmaHandler);
+    irq_set_enabled(DMA_IRQ_0, true);
+
+    dma_channel_start(static_cast<uint>(dmaChannels_[0]));
+    adc_run(true);
+}
+
+void AdcDriverBase::stopDmaCapture() {
+    adc_run(false);
+
+    irq_set_enabled(DMA_IRQ_0, false);
+
+    for (int channel : dmaChannels_) {
+        dma_channel_set_irq0_enabled(static_cast<uint>(channel), false);
+        dma_channel_abort(static_cast<uint>(channel));
+        dma_channel_acknowledge_irq0(static_cast<uint>(channel));
+    }
+
+    adc_fifo_setup(false, false, 0, false, false);
+    adc_fifo_drain();
+    adc_set_round_robin(0);
 }
 
-bool AdcDriver::onTimerFired() {
-    // ISR context - keep this FAST!
+const uint16_t* AdcDriverBase::takeCompletedBlock() {
+    // ISR context. Service the expected buffer first so a late IRQ with
+    // both channels pending still delivers in order.
+    size_t index = handoff_.getExpected();
+    uint channel = static_cast<uint>(dmaChannels_[index]);
+
+    if (!dma_channel_get_irq0_status(channel)) {
+        index = (index + 1) % BlockHandoff::NUM_BUFFERS;
+        channel = static_cast<uint>(dmaChannels_[index]);
+        if (!dma_channel_get_irq0_status(channel)) {
+            return nullptr;
+        }
+    }
+
+    dma_channel_acknowledge_irq0(channel);
 
-    // Select current channel
-    adc_select_input(currentChannel_);
+    // Rewind for the next time the other channel chains to this one.
+    // The transfer count reloads on trigger, so only the address moves.
+    dma_channel_set_write_addr(channel, handoff_.getBuffer(index), false);
 
-    // Read ADC (non-blocking, should be quick)
-    uint16_t sample = adc_read();
+    return handoff_.complete(index);
+}
 
-    // Call user callback if registered
-    if (sampleCallback_) {
-        sampleCallback_(static_cast<StringId>(currentChannel_), sample);
+const uint16_t* AdcDriverBase::decimateChannel(const uint16_t* rawBlock, size_t channel) {
+    if (OVERSAMPLING == 1) {
+        BlockHandoff::extractChannel(rawBlock, BLOCK_FRAMES, channel, channelBlock_.data());
+        return channelBlock_.data();
     }
 
-    // Round-robin to next channel
-    currentChannel_ = (currentChannel_ + 1) % NUM_STRINGS;
+    // The string straight out of the interleaved block, contiguous out
+    decimators_[channel].process(rawBlock + channel, BlockHandoff::BLOCK_FRAMES,
+                                 channelBlock_.data(), NUM_STRINGS);
 
-    return true; // Continue timer
+    return channelBlock_.data();
 }
 
 } // namespace BassMINT
@@ -1,59 +1,92 @@
 #pragma once
 
 #include "core/Types.h"
+#include "hal/AdcBlockHandoff.h"
+#include "hal/BoardConfig.h"
+#include "dsp/CicDecimator.h"
+#include <array>
 #include <cstdint>
-#include <functional>
+#include "hardware/adc.h"
 #include "pico/time.h"
 
 namespace BassMINT {
 
 /**
- * @brief ADC driver for 4-channel string sensing
+ * @brief How AdcDriver paces and collects conversions
+ */
+enum class AdcCaptureMode : uint8_t {
+    Timer,  // Repeating timer IRQ, one blocking adc_read per string per tick
+    Dma     // Free-running round-robin ADC, DMA ping-pong blocks
+};
+
+/**
+ * @brief Hardware side of the ADC driver (independent of the sink)
  *
- * Manages timer-driven ADC sampling of 4 OPT101 photodiode outputs.
- * Uses hardware timer + ADC round-robin to sample all 4 channels at SAMPLE_RATE_HZ.
+ * Samples 4 OPT101 photodiode outputs in one of two modes:
  *
- * Architecture:
- * - Timer IRQ triggers at SAMPLE_RATE_HZ
- * - Each IRQ reads one ADC channel in round-robin fashion
- * - Samples are pushed to per-string callbacks (typically ring buffers)
- * - ISR is kept minimal for low latency
+ * Both modes deliver SAMPLE_RATE_HZ per string (ADC_AGGREGATE_RATE_HZ
+ * frames, see core/Types.h); only DMA mode oversamples.
+ *
+ * Timer mode:
+ * - Timer IRQ triggers every ADC_TIMER_INTERVAL_US (once per frame)
+ * - Each IRQ reads all channels back to back (E, A, D, G)
+ * - Samples are pushed to the sink one at a time
+ *
+ * DMA mode:
+ * - ADC free-runs over channels 0-3 (round-robin mask), paced by the
+ *   clock divider at ADC_AGGREGATE_RATE_HZ * ADC_OVERSAMPLING, into its FIFO
+ * - Two chained DMA channels drain the FIFO into ping-pong buffers of
+ *   ADC_DMA_BLOCK_FRAMES * ADC_OVERSAMPLING interleaved frames
+ * - One DMA IRQ per block: a CIC decimator per string reads its string
+ *   out of the interleaved block and brings it back to
+ *   ADC_DMA_BLOCK_FRAMES samples at SAMPLE_RATE_HZ, which the sink gets
+ *   right away (one copy per sample); the other buffer keeps filling
+ *   meanwhile, so nothing is lost if the handler finishes within one
+ *   block time
+ *
+ * Use AdcDriver<Sink>, which adds the interrupt entry points.
  */
-class AdcDriver {
+class AdcDriverBase {
 public:
+    static constexpr size_t OVERSAMPLING = BoardConfig::ADC_OVERSAMPLING;
+
+    // Frames per block delivered to the sink (after decimation)
+    static constexpr size_t BLOCK_FRAMES = BoardConfig::ADC_DMA_BLOCK_FRAMES;
+
+    // Raw DMA blocks hold OVERSAMPLING conversions per delivered sample
+    using BlockHandoff = AdcBlockHandoff<BLOCK_FRAMES * OVERSAMPLING>;
+    using Decimator = CicDecimator<OVERSAMPLING>;
+
     /**
-     * @brief Callback for new ADC sample
-     * @param stringId Which string this sample is from
-     * @param sample Raw ADC value (12-bit, 0-4095)
+     * @brief Initialize ADC hardware and GPIO pins
+     * @param mode Capture mode used by startSampling()
      */
-    using SampleCallback = std::function<void(StringId stringId, uint16_t sample)>;
+    void init(AdcCaptureMode mode = AdcCaptureMode::Timer);
 
     /**
-     * @brief Initialize ADC hardware and GPIO pins
+     * @brief Stop ADC sampling
      */
-    void init();
+    void stopSampling();
 
     /**
-     * @brief Set callback for ADC samples
-     * @param callback Function to call when new sample arrives (from ISR context!)
+     * @brief Check if sampling is active
      */
-    void setSampleCallback(SampleCallback callback);
+    bool isSampling() const { return sampling_; }
 
     /**
-     * @brief Start timer-driven ADC sampling
-     * Begins calling the sample callback at SAMPLE_RATE_HZ per channel
+     * @brief Get the capture mode
      */
-    void startSampling();
+    AdcCaptureMode getCaptureMode() const { return mode_; }
 
     /**
-     * @brief Stop ADC sampling
+     * @brief DMA blocks delivered since init
      */
-    void stopSampling();
+    uint32_t getCompletedBlocks() const { return handoff_.getCompletedBlocks(); }
 
     /**
-     * @brief Check if sampling is active
+     * @brief DMA blocks lost to late interrupt handling
      */
-    bool isSampling() const { return sampling_; }
+    uint32_t getDroppedBlocks() const { return handoff_.getDroppedBlocks(); }
 
     /**
      * @brief Read a single ADC sample (blocking, for testing)
@@ -69,26 +102,134 @@ public:
      */
     static float rawToVoltage(uint16_t raw);
 
-private:
+protected:
+    /**
+     * @brief Start capture in the configured mode
+     * @param timerCallback Timer mode ISR (user_data = this, as AdcDriverBase*)
+     * @param dmaHandler DMA mode ISR
+     */
+    void startSampling(repeating_timer_callback_t timerCallback, void (*dmaHandler)());
+
     /**
-     * @brief Timer ISR callback (static for C linkage)
+     * @brief Read one frame in timer mode (ISR context)
+     * @param sink Called as sink(StringId, sample) for E, A, D, G
      */
-    static bool timerCallback(struct repeating_timer* t);
+    template<typename SinkFn>
+    static inline void readFrame(SinkFn&& sink) {
+        for (uint8_t channel = 0; channel < NUM_STRINGS; ++channel) {
+            adc_select_input(channel);
+            sink(static_cast<StringId>(channel), adc_read());
+        }
+    }
 
     /**
-     * @brief Instance method called from timer ISR
+     * @brief Acknowledge and re-arm the next finished DMA buffer (ISR context)
+     * @return Completed block, or nullptr once no completion is pending
      */
-    bool onTimerFired();
+    const uint16_t* takeCompletedBlock();
+
+    /**
+     * @brief Decimate one string of a raw DMA block (ISR context)
+     * @param rawBlock Interleaved block from takeCompletedBlock()
+     * @param channel String to take (0 .. NUM_STRINGS-1)
+     * @return BLOCK_FRAMES samples at SAMPLE_RATE_HZ, valid until the next call
+     */
+    const uint16_t* decimateChannel(const uint16_t* rawBlock, size_t channel);
+
+private:
+    void startDmaCapture(void (*dmaHandler)());
+    void stopDmaCapture();
 
-    SampleCallback sampleCallback_;
+    AdcCaptureMode mode_ = AdcCaptureMode::Timer;
     bool initialized_ = false;
     bool sampling_ = false;
 
-    // Round-robin state
-    uint8_t currentChannel_ = 0;
-
     // Timer handle
     struct repeating_timer timer_;
+
+    // DMA capture state
+    int dmaChannels_[BlockHandoff::NUM_BUFFERS] = {-1, -1};
+    BlockHandoff handoff_;
+
+    // Per-string oversampling filters and the string block just decimated
+    std::array<Decimator, NUM_STRINGS> decimators_;
+    std::array<uint16_t, BLOCK_FRAMES> channelBlock_{};
+};
+
+/**
+ * @brief ADC driver bound at compile time to the object receiving samples
+ *
+ * The ISR calls the sink directly instead of through a std::function, so
+ * with an inline sink the whole path from adc_read() to the ring buffer
+ * push compiles into the interrupt handler.
+ *
+ * Sink must provide (called from ISR context):
+ * - void onAdcSample(StringId string, uint16_t sample)       (timer mode)
+ * - void onAdcBlock(StringId string, const uint16_t* samples, size_t count)
+ *   (DMA mode; one string's samples, called for E, A, D, G per block)
+ *
+ * Only one driver per Sink type may be sampling at a time (the DMA IRQ
+ * has no user data, so it finds the driver through a static pointer).
+ *
+ * @tparam Sink Sample consumer type
+ */
+template<typename Sink>
+class AdcDriver : public AdcDriverBase {
+public:
+    /**
+     * @brief Constructor
+     * @param sink Receives samples/blocks; must outlive the driver
+     */
+    explicit AdcDriver(Sink& sink) : sink_(sink) {}
+
+    /**
+     * @brief Start ADC sampling in the configured mode
+     */
+    void startSampling() {
+        instance_ = this;
+        AdcDriverBase::startSampling(timerCallback, dmaIrqHandler);
+    }
+
+private:
+    Sink& sink_;
+
+    static inline AdcDriver* instance_ = nullptr;
+
+    /**
+     * @brief Timer ISR (static for C linkage)
+     */
+    static bool timerCallback(struct repeating_timer* t) {
+        // ISR context - keep this FAST!
+        // AdcDriverBase registered the timer, so user_data holds an
+        // AdcDriverBase*: recover that type before the downcast
+        auto* self = static_cast<AdcDriver*>(static_cast<AdcDriverBase*>(t->user_data));
+
+        // One frame per tick: every string gets SAMPLE_RATE_HZ, the ADC
+        // runs at ADC_AGGREGATE_RATE_HZ (4 conversions, ~2 µs each)
+        readFrame([self](StringId string, uint16_t sample) {
+            self->sink_.onAdcSample(string, sample);
+        });
+
+        return true; // Continue timer
+    }
+
+    /**
+     * @brief DMA IRQ handler (static for C linkage)
+     */
+    static void dmaIrqHandler() {
+        // ISR context - runs once per block
+        AdcDriver* self = instance_;
+        if (!self) {
+            return;
+        }
+
+        while (const uint16_t* block = self->takeCompletedBlock()) {
+            for (size_t channel = 0; channel < NUM_STRINGS; ++channel) {
+                self->sink_.onAdcBlock(static_cast<StringId>(channel),
+                                       self->decimateChannel(block, channel), BLOCK_FRAMES);
+            }
+        }
+    }
 };
 
 } // namespace BassMINT
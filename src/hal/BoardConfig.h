@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Types.h"
 #include <cstdint>
 
 namespace BassMINT {
@@ -59,10 +60,38 @@ constexpr uint8_t UART_MIDI_INSTANCE = 1; // UART1
 // MIDI baud rate (standard DIN-5 MIDI)
 constexpr uint32_t MIDI_BAUD_RATE = 31250;
 
+// Bytes queued for the UART TX interrupt (~80 ms of wire time at 320 µs
+// per byte)
+constexpr uint32_t MIDI_TX_QUEUE_SIZE = 256;
+
+// === USB-MIDI (BASSMINT_USB_MIDI) ===
+// pid.codes test VID/PID: fine on the bench, replace before distributing
+constexpr uint16_t USB_VENDOR_ID = 0x1209;
+constexpr uint16_t USB_PRODUCT_ID = 0x0001;
+
+// Event packets collected per main loop pass (4 bytes each; four strings'
+// Note Off/bend/Note On plus a fret SysEx bundle need 17)
+constexpr uint32_t USB_MIDI_TX_PACKETS = 32;
+
 // === Timing ===
-// ADC sample timer interval in microseconds
-// For 8kHz: 1000000 / 8000 = 125 µs
-constexpr uint32_t ADC_TIMER_INTERVAL_US = 125;
+// Timer capture: one tick per frame (all strings read back to back)
+// For 8kHz per string: 1000000 / 8000 = 125 µs
+constexpr uint32_t ADC_TIMER_INTERVAL_US = 1000000 / SAMPLE_RATE_HZ;
+
+static_assert(1000000 % SAMPLE_RATE_HZ == 0, "Timer interval must be whole microseconds");
+
+// ADC conversion clock (USB PLL); one conversion takes 96 cycles
+constexpr uint32_t ADC_CLOCK_HZ = 48000000;
+
+// DMA capture: frames (one sample per string) per ping-pong block, after
+// decimation. 32 frames @ 8kHz per string = 4 ms per block, 250 DMA
+// interrupts/s
+constexpr uint32_t ADC_DMA_BLOCK_FRAMES = 32;
+
+// DMA capture: conversions per delivered sample (power of 2, 1 = off).
+// The ADC runs at ADC_AGGREGATE_RATE_HZ * this and a CIC filter decimates
+// each string back to SAMPLE_RATE_HZ: 4x -> 128 ksps, 1 KB per DMA buffer
+constexpr uint32_t ADC_OVERSAMPLING = 4;
 
 } // namespace BoardConfig
 } // namespace BassMINT
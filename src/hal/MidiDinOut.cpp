@@ -2,6 +2,8 @@
 #include "hal/BoardConfig.h"
 #include "hardware/uart.h"
 #include "hardware/gpio.h"
+#include "hardware/irq.h"
+#include "pico/stdlib.h"
 
 namespace BassMINT {
 
@@ -9,6 +11,13 @@ namespace BassMINT {
 static constexpr uint8_t MIDI_NOTE_OFF = 0x80;
 static constexpr uint8_t MIDI_NOTE_ON = 0x90;
 static constexpr uint8_t MIDI_CONTROL_CHANGE = 0xB0;
+static constexpr uint8_t MIDI_PITCH_BEND = 0xE0;
+static constexpr uint8_t MIDI_STATUS_FIRST = 0x80;   // Bytes below are data
+static constexpr uint8_t MIDI_SYSTEM_FIRST = 0xF0;   // SysEx + System Common
+static constexpr uint8_t MIDI_REALTIME_FIRST = 0xF8; // System Real-Time
+
+// Initialized instance, for the UART IRQ handler
+static MidiDinOut* g_midiOut = nullptr;
 
 void MidiDinOut::init() {
     if (initialized_) {
@@ -24,25 +33,109 @@ void MidiDinOut::init() {
     // MIDI is 8-N-1 (default for Pico SDK UART)
     // No need to configure data bits, stop bits, parity explicitly
 
+    // TX interrupt refills the FIFO from the queue; it stays masked while
+    // the queue is empty (kickTransmit() unmasks it)
+    g_midiOut = this;
+    uart_set_irq_enables(uart1, false, false);
+    irq_set_exclusive_handler(UART1_IRQ, uartIrqHandler);
+    irq_set_enabled(UART1_IRQ, true);
+
     initialized_ = true;
 }
 
 void MidiDinOut::sendByte(uint8_t byte) {
+    sendMessage(&byte, 1);
+}
+
+bool MidiDinOut::sendMessage(const uint8_t* data, size_t length) {
+    if (!initialized_ || !data) {
+        return false;
+    }
+
+    if (!txQueue_.enqueue(data, length)) {
+        return false; // Dropped, counted by the queue
+    }
+
+    trackStatus(data, length);
+    kickTransmit();
+    return true;
+}
+
+void MidiDinOut::sendChannelMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+    uint8_t msg[3] = {status, data1, data2};
+
+    // The receiver still holds this status from the previous message
+    if (runningStatus_ && status == lastStatus_) {
+        sendMessage(msg + 1, 2);
+    } else {
+        sendMessage(msg, 3);
+    }
+}
+
+void MidiDinOut::trackStatus(const uint8_t* data, size_t length) {
+    for (size_t i = 0; i < length; ++i) {
+        uint8_t byte = data[i];
+
+        // Data bytes and real-time bytes leave running status unchanged
+        if (byte < MIDI_STATUS_FIRST || byte >= MIDI_REALTIME_FIRST) {
+            continue;
+        }
+
+        // A channel status becomes the running status; SysEx and System
+        // Common cancel it
+        lastStatus_ = (byte < MIDI_SYSTEM_FIRST) ? byte : 0;
+    }
+}
+
+void MidiDinOut::flush() {
     if (!initialized_) {
         return;
     }
 
-    // Blocking write (MIDI is slow, this is fine)
-    uart_putc_raw(uart1, byte);
+    while (!txQueue_.isEmpty()) {
+        tight_loop_contents();
+    }
+
+    uart_tx_wait_blocking(uart1);
 }
 
-void MidiDinOut::sendMessage(const uint8_t* data, size_t length) {
-    if (!initialized_ || !data) {
+bool MidiDinOut::isTxIdle() const {
+    return txQueue_.isEmpty() && (uart_get_hw(uart1)->fr & UART_UARTFR_TXFE_BITS);
+}
+
+void MidiDinOut::kickTransmit() {
+    // The PL011 raises its TX interrupt only when the FIFO drains through
+    // the trigger level, so an idle UART has to be primed from here. The
+    // interrupt is masked meanwhile, keeping the queue's consumer side to
+    // one context at a time.
+    uart_set_irq_enables(uart1, false, false);
+
+    if (fillTxFifo()) {
+        uart_set_irq_enables(uart1, false, true);
+    }
+}
+
+bool MidiDinOut::fillTxFifo() {
+    uint8_t byte;
+    while (uart_is_writable(uart1)) {
+        if (!txQueue_.pop(byte)) {
+            return false;
+        }
+        uart_putc_raw(uart1, static_cast<char>(byte));
+    }
+    return !txQueue_.isEmpty();
+}
+
+void MidiDinOut::uartIrqHandler() {
+    // ISR context - at most 32 bytes per call (FIFO depth)
+    MidiDinOut* self = g_midiOut;
+    if (!self) {
         return;
     }
 
-    for (size_t i = 0; i < length; ++i) {
-        uart_putc_raw(uart1, data[i]);
+    // Nothing left: mask, or the below-level interrupt keeps firing
+    if (!self->fillTxFifo()) {
+        uart_set_irq_enables(uart1, false, false);
     }
 }
 
@@ -56,12 +149,7 @@ void MidiDinOut::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
     note &= 0x7F;     // 0-127
     velocity &= 0x7F; // 0-127
 
-    uint8_t msg[3] = {
-        static_cast<uint8_t>(MIDI_NOTE_ON | channel),
-        note,
-        velocity
-    };
-    sendMessage(msg, 3);
+    sendChannelMessage(static_cast<uint8_t>(MIDI_NOTE_ON | channel), note, velocity);
 }
 
 void MidiDinOut::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
@@ -73,12 +161,13 @@ void MidiDinOut::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
     note &= 0x7F;
     velocity &= 0x7F;
 
-    uint8_t msg[3] = {
-        static_cast<uint8_t>(MIDI_NOTE_OFF | channel),
-        note,
-        velocity
-    };
-    sendMessage(msg, 3);
+    // Note On velocity 0 means Note Off and keeps Note On's running status
+    if (runningStatus_) {
+        sendChannelMessage(static_cast<uint8_t>(MIDI_NOTE_ON | channel), note, 0);
+        return;
+    }
+
+    sendChannelMessage(static_cast<uint8_t>(MIDI_NOTE_OFF | channel), note, velocity);
 }
 
 void MidiDinOut::sendControlChange(uint8_t channel, uint8_t controller, uint8_t value) {
@@ -90,12 +179,21 @@ void MidiDinOut::sendControlChange(uint8_t channel, uint8_t controller, uint8_t
     controller &= 0x7F;
     value &= 0x7F;
 
-    uint8_t msg[3] = {
-        static_cast<uint8_t>(MIDI_CONTROL_CHANGE | channel),
-        controller,
-        value
-    };
-    sendMessage(msg, 3);
+    sendChannelMessage(static_cast<uint8_t>(MIDI_CONTROL_CHANGE | channel), controller, value);
+}
+
+void MidiDinOut::sendPitchBend(uint8_t channel, uint16_t value) {
+    if (!initialized_) {
+        return;
+    }
+
+    channel &= 0x0F;
+    value &= 0x3FFF;
+
+    // LSB first
+    sendChannelMessage(static_cast<uint8_t>(MIDI_PITCH_BEND | channel),
+                       static_cast<uint8_t>(value & 0x7F),
+                       static_cast<uint8_t>(value >> 7));
 }
 
 void MidiDinOut::sendSysEx(const uint8_t* data, size_t length) {
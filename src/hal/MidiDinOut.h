@@ -1,5 +1,7 @@
 #pragma once
 
+#include "hal/BoardConfig.h"
+#include "hal/MidiTxQueue.h"
 #include <cstdint>
 #include <cstddef>
 
@@ -13,7 +15,20 @@ namespace BassMINT {
  * - Sends raw MIDI bytes
  * - Convenience methods for Note On/Off
  *
- * Thread-safe: can be called from main loop (not ISR)
+ * Non-blocking: every send queues the whole message in a MidiTxQueue and
+ * returns; the UART TX interrupt refills the 32-byte hardware FIFO from
+ * the queue. Messages that do not fit are dropped per the queue's policy
+ * (SysEx before notes) and counted.
+ *
+ * Running status (optional, setRunningStatus()): a channel message whose
+ * status byte equals the last one sent goes out without it, and Note Off
+ * is sent as Note On with velocity 0 so it shares Note On's status.
+ * SysEx and System Common bytes cancel running status; System Real-Time
+ * bytes (0xF8-0xFF) leave it in place, as MIDI 1.0 specifies.
+ *
+ * Call from the main loop on the core that ran init() (not ISR); only one
+ * instance may be initialized (the UART IRQ finds it through a static
+ * pointer).
  */
 class MidiDinOut {
 public:
@@ -23,6 +38,8 @@ public:
      */
     void init();
 
+    using TxQueue = MidiTxQueue<BoardConfig::MIDI_TX_QUEUE_SIZE>;
+
     /**
      * @brief Send a single MIDI byte
      * @param byte Byte to transmit
@@ -33,8 +50,9 @@ public:
      * @brief Send a MIDI message (raw bytes)
      * @param data Pointer to message bytes
      * @param length Number of bytes to send
+     * @return true if queued, false if dropped (queue full)
      */
-    void sendMessage(const uint8_t* data, size_t length);
+    bool sendMessage(const uint8_t* data, size_t length);
 
     /**
      * @brief Send MIDI Note On message
@@ -48,7 +66,7 @@ public:
      * @brief Send MIDI Note Off message
      * @param channel MIDI channel (0-15)
      * @param note MIDI note number (0-127)
-     * @param velocity Release velocity (0-127)
+     * @param velocity Release velocity (0-127, not sent with running status)
      */
     void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity);
 
@@ -60,6 +78,13 @@ public:
      */
     void sendControlChange(uint8_t channel, uint8_t controller, uint8_t value);
 
+    /**
+     * @brief Send MIDI Pitch Bend message
+     * @param channel MIDI channel (0-15)
+     * @param value 14-bit bend (0-16383, 8192 = none)
+     */
+    void sendPitchBend(uint8_t channel, uint16_t value);
+
     /**
      * @brief Send System Exclusive message
      * @param data SysEx payload (including F0 start and F7 end)
@@ -67,8 +92,86 @@ public:
      */
     void sendSysEx(const uint8_t* data, size_t length);
 
+    /**
+     * @brief Enable or disable running status (off after init)
+     *
+     * The next channel message always carries its status byte.
+     */
+    void setRunningStatus(bool enabled) {
+        runningStatus_ = enabled;
+        lastStatus_ = 0;
+    }
+
+    /**
+     * @brief Check if running status is enabled
+     */
+    bool isRunningStatus() const { return runningStatus_; }
+
+    /**
+     * @brief Block until every queued byte has left the UART
+     */
+    void flush();
+
+    /**
+     * @brief Check if nothing is queued or waiting in the UART FIFO
+     *
+     * The last byte may still be shifting out (up to 320 µs).
+     */
+    bool isTxIdle() const;
+
+    /**
+     * @brief Bytes waiting for the wire
+     */
+    size_t getPendingBytes() const { return txQueue_.getPending(); }
+
+    /**
+     * @brief Messages dropped because the TX queue was full
+     */
+    uint32_t getDroppedMessages() const { return txQueue_.getDroppedMessages(); }
+
+    /**
+     * @brief Bytes of the dropped messages
+     */
+    uint32_t getDroppedBytes() const { return txQueue_.getDroppedBytes(); }
+
+    /**
+     * @brief Highest TX queue fill since init (bytes)
+     */
+    size_t getMaxPendingBytes() const { return txQueue_.getMaxPending(); }
+
 private:
     bool initialized_ = false;
+    TxQueue txQueue_;
+
+    // Running status: last status byte queued (0 = none in effect)
+    bool runningStatus_ = false;
+    uint8_t lastStatus_ = 0;
+
+    /**
+     * @brief Send a 3-byte channel message, omitting a running status byte
+     */
+    void sendChannelMessage(uint8_t status, uint8_t data1, uint8_t data2);
+
+    /**
+     * @brief Follow the status bytes of a queued message
+     */
+    void trackStatus(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Start or continue transmission after an enqueue
+     */
+    void kickTransmit();
+
+    /**
+     * @brief Move queued bytes into the UART FIFO while it has room
+     * @return true if the queue still holds bytes
+     */
+    bool fillTxFifo();
+
+    /**
+     * @brief UART TX interrupt handler
+     */
+    static void uartIrqHandler();
 };
 
 } // namespace BassMINT
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "dsp/SpscRingBuffer.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Byte queue between the MIDI senders and the UART TX interrupt
+ *
+ * The main loop enqueues whole messages and returns at once; the UART TX
+ * IRQ pops bytes into the hardware FIFO as it drains (MidiDinOut). At
+ * 31250 baud one byte takes 320 µs on the wire, so a Note On plus its
+ * SysEx is ~4 ms of transmission the main loop no longer waits for.
+ *
+ * Backpressure policy (the queue only fills if messages are produced
+ * faster than the wire rate for a sustained time):
+ * - Messages are accepted whole or not at all; a partial message would
+ *   corrupt the stream for the receiver
+ * - SysEx is only accepted while it leaves CHANNEL_RESERVE bytes free, so
+ *   Note On/Off (stuck notes are worse than a missing fret update) still
+ *   fit when SysEx has backed the queue up
+ * - A rejected message is dropped (the newest one, never queued bytes)
+ *   and counted
+ *
+ * No hardware access, so the queue logic does not depend on the Pico SDK.
+ * Producer and consumer follow SpscRingBuffer's rules: enqueue() from one
+ * context, pop() from one other context (an IRQ on the same core).
+ *
+ * @tparam Capacity Queue size in bytes (power of 2)
+ */
+template<size_t Capacity>
+class MidiTxQueue {
+public:
+    static constexpr size_t CAPACITY = Capacity;
+
+    // Note Off + Note On for every string (4 × 2 × 3 bytes)
+    static constexpr size_t CHANNEL_RESERVE = 24;
+
+    static_assert(Capacity > CHANNEL_RESERVE, "Queue must hold more than the channel reserve");
+
+    /**
+     * @brief Queue one complete MIDI message (producer)
+     * @param data Message bytes (status byte first)
+     * @param length Number of bytes
+     * @return true if queued, false if dropped
+     */
+    bool enqueue(const uint8_t* data, size_t length) {
+        if (!data || length == 0) {
+            return false;
+        }
+
+        size_t needed = length;
+        if (data[0] == SYSEX_START) {
+            needed += CHANNEL_RESERVE;
+        }
+
+        if (bytes_.getFree() < needed) {
+            droppedMessages_++;
+            droppedBytes_ += static_cast<uint32_t>(length);
+            return false;
+        }
+
+        bytes_.pushBlock(data, length);
+
+        size_t pending = bytes_.capacity() - bytes_.getFree();
+        if (pending > maxPending_) {
+            maxPending_ = pending;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Take the next byte for the wire (consumer, IRQ context)
+     * @return true if a byte was available
+     */
+    bool pop(uint8_t& byte) {
+        return bytes_.pop(byte);
+    }
+
+    /**
+     * @brief Check if nothing is waiting (consumer)
+     */
+    bool isEmpty() const {
+        return bytes_.isEmpty();
+    }
+
+    /**
+     * @brief Bytes waiting for the wire (producer)
+     */
+    size_t getPending() const {
+        return bytes_.capacity() - bytes_.getFree();
+    }
+
+    /**
+     * @brief Messages dropped under backpressure
+     */
+    uint32_t getDroppedMessages() const { return droppedMessages_; }
+
+    /**
+     * @brief Bytes of the dropped messages
+     */
+    uint32_t getDroppedBytes() const { return droppedBytes_; }
+
+    /**
+     * @brief Highest number of bytes ever waiting (high-water mark)
+     */
+    size_t getMaxPending() const { return maxPending_; }
+
+private:
+    static constexpr uint8_t SYSEX_START = 0xF0;
+
+    SpscRingBuffer<uint8_t, Capacity> bytes_;
+    uint32_t droppedMessages_ = 0;
+    uint32_t droppedBytes_ = 0;
+    size_t maxPending_ = 0;
+};
+
+} // namespace BassMINT
@@ -0,0 +1,96 @@
+#include "hal/UsbMidiOut.h"
+#include "pico/time.h"
+#include "tusb.h"
+
+namespace BassMINT {
+
+void UsbMidiOut::initDevice() {
+    tusb_init();
+}
+
+void UsbMidiOut::serviceFor(uint32_t ms) {
+    // Once the serial port is open, printf() runs tud_task() itself while
+    // it writes, so boot output after this is not lost
+    absolute_time_t end = make_timeout_time_ms(ms);
+    while (!time_reached(end) && !tud_cdc_connected()) {
+        tud_task();
+    }
+}
+
+bool UsbMidiOut::task() {
+    tud_task();
+
+    // Edge, not level: setup is repeated once per (re)connection
+    bool mounted = tud_midi_mounted();
+    bool opened = mounted && !mounted_;
+    mounted_ = mounted;
+    return opened;
+}
+
+bool UsbMidiOut::isConnected() const {
+    return tud_midi_mounted();
+}
+
+void UsbMidiOut::sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+    reserve(1);
+    packets_.addNoteOn(channel, note, velocity);
+}
+
+void UsbMidiOut::sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
+    reserve(1);
+    packets_.addNoteOff(channel, note, velocity);
+}
+
+void UsbMidiOut::sendControlChange(uint8_t channel, uint8_t controller, uint8_t value) {
+    reserve(1);
+    packets_.addControlChange(channel, controller, value);
+}
+
+void UsbMidiOut::sendPitchBend(uint8_t channel, uint16_t value) {
+    reserve(1);
+    packets_.addPitchBend(channel, value);
+}
+
+void UsbMidiOut::sendSysEx(const uint8_t* data, size_t length) {
+    reserve(Packetizer::packetsForSysEx(length));
+    if (!packets_.addSysEx(data, length)) {
+        droppedPackets_ += static_cast<uint32_t>(Packetizer::packetsForSysEx(length));
+    }
+}
+
+void UsbMidiOut::reserve(size_t packets) {
+    if (packets_.getFreePackets() < packets) {
+        flush();
+    }
+}
+
+void UsbMidiOut::flush() {
+    size_t count = packets_.getPacketCount();
+    if (count == 0) {
+        return;
+    }
+
+    if (!tud_midi_mounted()) {
+        droppedPackets_ += static_cast<uint32_t>(count);
+        packets_.clear();
+        return;
+    }
+
+    // The first write starts a transfer if the IN endpoint is free; the
+    // rest are written long before it completes, wait in the class FIFO
+    // and leave together when tud_task() sees the completion
+    const uint8_t* packet = packets_.data();
+    size_t written = 0;
+    for (; written < count; ++written, packet += Packetizer::PACKET_SIZE) {
+        if (!tud_midi_packet_write(packet)) {
+            break; // Class FIFO full: host is not reading
+        }
+    }
+
+    transfers_++;
+    sentPackets_ += static_cast<uint32_t>(written);
+    droppedPackets_ += static_cast<uint32_t>(count - written);
+    packets_.clear();
+}
+
+} // namespace BassMINT
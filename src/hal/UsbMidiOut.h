@@ -0,0 +1,104 @@
+#pragma once
+
+#include "hal/BoardConfig.h"
+#include "hal/UsbMidiPacketizer.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief USB-MIDI output (TinyUSB MIDI class, next to the CDC serial port)
+ *
+ * Same send calls as MidiDinOut, but messages are only packed into
+ * USB-MIDI event packets (UsbMidiPacketizer); flush() writes everything
+ * collected to the TinyUSB class FIFO at once. Call flush() once per main
+ * loop pass: the first packet starts a transfer and the rest of the pass'
+ * events follow together in the next one. A message that does not fit
+ * the packet buffer flushes it first.
+ *
+ * Full-speed USB moves a 64-byte packet of 16 events in well under a
+ * millisecond; the 31250-baud DIN link needs 320 µs per byte.
+ *
+ * Only in BASSMINT_USB_MIDI builds, where the application owns TinyUSB:
+ * initDevice() must run before stdio_init_all(), serviceFor() in place of
+ * the boot delay and task() every main loop pass (it also services the
+ * USB serial port). Main loop only.
+ */
+class UsbMidiOut {
+public:
+    using Packetizer = UsbMidiPacketizer<BoardConfig::USB_MIDI_TX_PACKETS>;
+
+    /**
+     * @brief Start the USB device stack (before stdio_init_all())
+     */
+    static void initDevice();
+
+    /**
+     * @brief Run the USB device stack during boot, before the main loop
+     *
+     * Nothing else calls tud_task() in this build (pico_stdio_usb has no
+     * background task once the application links TinyUSB): enumeration
+     * and the serial port's line state wait for it.
+     *
+     * @param ms Longest wait; returns early once the serial port is open
+     */
+    static void serviceFor(uint32_t ms);
+
+    /**
+     * @brief Run the USB device stack (every main loop pass)
+     * @return true on the pass a host has just opened the MIDI interface
+     */
+    bool task();
+
+    /**
+     * @brief Check if a host has opened the MIDI interface
+     */
+    bool isConnected() const;
+
+    void sendNoteOn(uint8_t channel, uint8_t note, uint8_t velocity);
+    void sendNoteOff(uint8_t channel, uint8_t note, uint8_t velocity);
+    void sendControlChange(uint8_t channel, uint8_t controller, uint8_t value);
+    void sendPitchBend(uint8_t channel, uint16_t value);
+
+    /**
+     * @brief Send System Exclusive message
+     * @param data SysEx message (including F0 start and F7 end)
+     * @param length Total message length
+     */
+    void sendSysEx(const uint8_t* data, size_t length);
+
+    /**
+     * @brief Hand the collected packets to TinyUSB
+     */
+    void flush();
+
+    /**
+     * @brief Transfers handed to TinyUSB
+     */
+    uint32_t getTransfers() const { return transfers_; }
+
+    /**
+     * @brief Event packets handed to TinyUSB
+     */
+    uint32_t getSentPackets() const { return sentPackets_; }
+
+    /**
+     * @brief Event packets dropped (no host, or host not reading)
+     */
+    uint32_t getDroppedPackets() const { return droppedPackets_; }
+
+private:
+    /**
+     * @brief Make room for a message of the given packet count
+     */
+    void reserve(size_t packets);
+
+    Packetizer packets_;
+    bool mounted_ = false;
+    uint32_t transfers_ = 0;
+    uint32_t sentPackets_ = 0;
+    uint32_t droppedPackets_ = 0;
+};
+
+} // namespace BassMINT
@@ -0,0 +1,157 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace BassMINT {
+
+/**
+ * @brief Packs MIDI messages into USB-MIDI 1.0 event packets
+ *
+ * USB-MIDI carries MIDI in 4-byte event packets: a header byte (cable
+ * number << 4 | Code Index Number) and up to three MIDI bytes, zero padded.
+ * Channel messages take one packet each; SysEx is split into three-byte
+ * pieces (CIN 0x4) with a closing packet carrying the last one to three
+ * bytes (CIN 0x5/0x6/0x7). There is no running status on USB.
+ *
+ * Messages accumulate in a fixed buffer so UsbMidiOut can hand a whole
+ * main loop pass to the USB stack at once. Like MidiTxQueue,
+ * messages are added whole or not at all (a SysEx split across transfers
+ * would be fine on USB, but a half-written one left behind by a full
+ * buffer would not).
+ *
+ * No hardware access, so the packing does not depend on the Pico SDK.
+ *
+ * @tparam MaxPackets Buffer size in event packets
+ */
+template<size_t MaxPackets>
+class UsbMidiPacketizer {
+public:
+    static constexpr size_t PACKET_SIZE = 4;
+    static constexpr size_t MAX_PACKETS = MaxPackets;
+
+    // Code Index Numbers (USB-MIDI 1.0, table 4-1)
+    static constexpr uint8_t CIN_SYSEX_START = 0x4;  // Or continue, 3 bytes
+    static constexpr uint8_t CIN_SYSEX_END_1 = 0x5;
+    static constexpr uint8_t CIN_SYSEX_END_2 = 0x6;
+    static constexpr uint8_t CIN_SYSEX_END_3 = 0x7;
+
+    /**
+     * @brief Constructor
+     * @param cable Virtual cable number (0-15)
+     */
+    explicit UsbMidiPacketizer(uint8_t cable = 0)
+        : cable_(static_cast<uint8_t>((cable & 0x0F) << 4))
+    {
+    }
+
+    /**
+     * @brief Packets a SysEx message of the given length takes
+     */
+    static constexpr size_t packetsForSysEx(size_t length) {
+        return (length + 2) / 3;
+    }
+
+    /**
+     * @brief Add a channel voice message (Note On/Off, CC, Pitch Bend, ...)
+     * @param status Status byte (0x80-0xEF)
+     * @param data1 First data byte
+     * @param data2 Second data byte (ignored for 2-byte messages)
+     * @return true if added, false if full or not a channel message
+     */
+    bool addChannelMessage(uint8_t status, uint8_t data1, uint8_t data2) {
+        if (status < 0x80 || status >= 0xF0 || count_ >= MaxPackets) {
+            return false;
+        }
+
+        // Program Change and Channel Pressure carry one data byte
+        uint8_t kind = status & 0xF0;
+        bool twoBytes = (kind == 0xC0 || kind == 0xD0);
+
+        uint8_t* packet = &packets_[count_ * PACKET_SIZE];
+        packet[0] = static_cast<uint8_t>(cable_ | (status >> 4));
+        packet[1] = status;
+        packet[2] = data1 & 0x7F;
+        packet[3] = twoBytes ? 0 : static_cast<uint8_t>(data2 & 0x7F);
+        count_++;
+        return true;
+    }
+
+    bool addNoteOn(uint8_t channel, uint8_t note, uint8_t velocity) {
+        return addChannelMessage(static_cast<uint8_t>(0x90 | (channel & 0x0F)), note, velocity);
+    }
+
+    bool addNoteOff(uint8_t channel, uint8_t note, uint8_t velocity) {
+        return addChannelMessage(static_cast<uint8_t>(0x80 | (channel & 0x0F)), note, velocity);
+    }
+
+    bool addControlChange(uint8_t channel, uint8_t controller, uint8_t value) {
+        return addChannelMessage(static_cast<uint8_t>(0xB0 | (channel & 0x0F)), controller, value);
+    }
+
+    /**
+     * @brief Add a Pitch Bend message
+     * @param value 14-bit bend (8192 = none)
+     */
+    bool addPitchBend(uint8_t channel, uint16_t value) {
+        return addChannelMessage(static_cast<uint8_t>(0xE0 | (channel & 0x0F)),
+                                 static_cast<uint8_t>(value & 0x7F),
+                                 static_cast<uint8_t>((value >> 7) & 0x7F));
+    }
+
+    /**
+     * @brief Add a complete SysEx message
+     * @param data Message bytes, F0 through F7
+     * @param length Number of bytes (at least 2)
+     * @return true if added, false if full or malformed
+     */
+    bool addSysEx(const uint8_t* data, size_t length) {
+        if (!data || length < 2 || data[0] != 0xF0 || data[length - 1] != 0xF7) {
+            return false;
+        }
+        if (packetsForSysEx(length) > MaxPackets - count_) {
+            return false;
+        }
+
+        size_t pos = 0;
+        while (pos < length) {
+            size_t remaining = length - pos;
+            size_t chunk = (remaining > 3) ? 3 : remaining;
+
+            uint8_t cin = CIN_SYSEX_START;
+            if (remaining <= 3) {
+                cin = static_cast<uint8_t>(CIN_SYSEX_END_1 + (chunk - 1));
+            }
+
+            uint8_t* packet = &packets_[count_ * PACKET_SIZE];
+            packet[0] = static_cast<uint8_t>(cable_ | cin);
+            for (size_t i = 0; i < 3; ++i) {
+                packet[1 + i] = (i < chunk) ? data[pos + i] : 0;
+            }
+            count_++;
+            pos += chunk;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Packed event packets (getByteCount() bytes)
+     */
+    const uint8_t* data() const { return packets_.data(); }
+
+    size_t getPacketCount() const { return count_; }
+    size_t getByteCount() const { return count_ * PACKET_SIZE; }
+    size_t getFreePackets() const { return MaxPackets - count_; }
+    bool isEmpty() const { return count_ == 0; }
+
+    void clear() { count_ = 0; }
+
+private:
+    std::array<uint8_t, MaxPackets * PACKET_SIZE> packets_ = {};
+    size_t count_ = 0;
+    uint8_t cable_;
+};
+
+} // namespace BassMINT
@@ -0,0 +1,108 @@
+/**
+ * @file UsbDescriptors.cpp
+ * @brief TinyUSB descriptor callbacks for the CDC + MIDI composite device
+ */
+
+#include "hal/usb/UsbDescriptors.h"
+#include "hal/BoardConfig.h"
+#include "pico/unique_id.h"
+#include "tusb.h"
+#include <cstring>
+
+using namespace BassMINT;
+using namespace BassMINT::UsbDescriptors;
+
+namespace {
+
+enum StringIndex : uint8_t {
+    STR_LANGUAGE = 0,
+    STR_MANUFACTURER,
+    STR_PRODUCT,
+    STR_SERIAL,
+    STR_CDC,
+    STR_MIDI,
+    STR_COUNT
+};
+
+const tusb_desc_device_t DEVICE_DESCRIPTOR = {
+    sizeof(tusb_desc_device_t),     // bLength
+    TUSB_DESC_DEVICE,               // bDescriptorType
+    0x0200,                         // bcdUSB
+    TUSB_CLASS_MISC,                // bDeviceClass: IAD composite
+    MISC_SUBCLASS_COMMON,
+    MISC_PROTOCOL_IAD,
+    CFG_TUD_ENDPOINT0_SIZE,
+    BoardConfig::USB_VENDOR_ID,
+    BoardConfig::USB_PRODUCT_ID,
+    0x0100,                         // bcdDevice
+    STR_MANUFACTURER,
+    STR_PRODUCT,
+    STR_SERIAL,
+    1                               // bNumConfigurations
+};
+
+constexpr uint16_t CONFIG_TOTAL_LENGTH =
+    TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + TUD_MIDI_DESC_LEN;
+
+const uint8_t CONFIG_DESCRIPTOR[] = {
+    TUD_CONFIG_DESCRIPTOR(1, ITF_COUNT, 0, CONFIG_TOTAL_LENGTH, 0x00, 100),
+    TUD_CDC_DESCRIPTOR(ITF_CDC, STR_CDC, EP_CDC_NOTIFY, 8,
+                       EP_CDC_OUT, EP_CDC_IN, BULK_PACKET_SIZE),
+    TUD_MIDI_DESCRIPTOR(ITF_MIDI, STR_MIDI, EP_MIDI_OUT, EP_MIDI_IN, BULK_PACKET_SIZE)
+};
+
+const char* const STRINGS[STR_COUNT] = {
+    nullptr,            // Language (handled below)
+    "BassMINT",
+    "BassMINT Bass MIDI Controller",
+    nullptr,            // Serial: board unique ID
+    "BassMINT Serial",
+    "BassMINT MIDI"
+};
+
+// Longest string plus header, in UTF-16 code units
+uint16_t g_stringDescriptor[32];
+
+} // namespace
+
+const uint8_t* tud_descriptor_device_cb(void) {
+    return reinterpret_cast<const uint8_t*>(&DEVICE_DESCRIPTOR);
+}
+
+const uint8_t* tud_descriptor_configuration_cb(uint8_t index) {
+    (void)index;
+    return CONFIG_DESCRIPTOR;
+}
+
+const uint16_t* tud_descriptor_string_cb(uint8_t index, uint16_t langid) {
+    (void)langid;
+
+    size_t length = 0;
+
+    if (index == STR_LANGUAGE) {
+        g_stringDescriptor[1] = 0x0409; // English (US)
+        length = 1;
+    } else if (index < STR_COUNT) {
+        char serial[2 * PICO_UNIQUE_BOARD_ID_SIZE_BYTES + 1];
+        const char* text = STRINGS[index];
+        if (index == STR_SERIAL) {
+            pico_get_unique_board_id_string(serial, sizeof(serial));
+            text = serial;
+        }
+
+        constexpr size_t maxLength = sizeof(g_stringDescriptor) / sizeof(g_stringDescriptor[0]) - 1;
+        length = strlen(text);
+        if (length > maxLength) {
+            length = maxLength;
+        }
+        for (size_t i = 0; i < length; ++i) {
+            g_stringDescriptor[1 + i] = static_cast<uint8_t>(text[i]);
+        }
+    } else {
+        return nullptr;
+    }
+
+    // Header: total length in bytes, descriptor type
+    g_stringDescriptor[0] = static_cast<uint16_t>((TUSB_DESC_STRING << 8) | (2 * length + 2));
+    return g_stringDescriptor;
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+/**
+ * @file UsbDescriptors.h
+ * @brief Interface and endpoint numbers of the CDC + MIDI composite device
+ */
+
+#include <cstdint>
+
+namespace BassMINT {
+namespace UsbDescriptors {
+
+enum Interface : uint8_t {
+    ITF_CDC = 0,
+    ITF_CDC_DATA,
+    ITF_MIDI,            // Audio Control
+    ITF_MIDI_STREAMING,
+    ITF_COUNT
+};
+
+constexpr uint8_t EP_CDC_NOTIFY = 0x81;
+constexpr uint8_t EP_CDC_OUT = 0x02;
+constexpr uint8_t EP_CDC_IN = 0x82;
+constexpr uint8_t EP_MIDI_OUT = 0x03;
+constexpr uint8_t EP_MIDI_IN = 0x83;
+
+constexpr uint16_t BULK_PACKET_SIZE = 64; // Full speed
+
+} // namespace UsbDescriptors
+} // namespace BassMINT
@@ -0,0 +1,55 @@
+/**
+ * @file tusb_config.h
+ * @brief TinyUSB device configuration (BASSMINT_USB_MIDI builds only)
+ *
+ * Composite device: CDC (stdio over USB serial, as before) + USB-MIDI.
+ * The application owns TinyUSB in this build: UsbMidiOut::initDevice()
+ * calls tusb_init() before stdio_init_all(), UsbMidiOut::serviceFor()
+ * runs tud_task() through the boot delay and App::tick() after that;
+ * pico_stdio_usb then only uses the CDC interface (and has no background
+ * task of its own).
+ */
+
+#ifndef BASSMINT_TUSB_CONFIG_H
+#define BASSMINT_TUSB_CONFIG_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#ifndef CFG_TUSB_MCU
+#error CFG_TUSB_MCU must be defined (set by the Pico SDK)
+#endif
+
+#ifndef CFG_TUSB_RHPORT0_MODE
+#define CFG_TUSB_RHPORT0_MODE   (OPT_MODE_DEVICE | OPT_MODE_FULL_SPEED)
+#endif
+
+#ifndef CFG_TUSB_OS
+#define CFG_TUSB_OS             OPT_OS_PICO
+#endif
+
+#define CFG_TUD_ENABLED         1
+
+#define CFG_TUD_ENDPOINT0_SIZE  64
+
+// Device classes
+#define CFG_TUD_CDC             1
+#define CFG_TUD_MIDI            1
+#define CFG_TUD_MSC             0
+#define CFG_TUD_HID             0
+#define CFG_TUD_VENDOR          0
+
+// CDC FIFOs (stdio)
+#define CFG_TUD_CDC_RX_BUFSIZE  256
+#define CFG_TUD_CDC_TX_BUFSIZE  256
+
+// MIDI FIFOs: TX holds two main loop passes' worth of event packets
+#define CFG_TUD_MIDI_RX_BUFSIZE 64
+#define CFG_TUD_MIDI_TX_BUFSIZE 256
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BASSMINT_TUSB_CONFIG_H
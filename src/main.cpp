@@ -22,17 +22,35 @@
  */
 
 #include "app/App.h"
+#ifdef BASSMINT_BENCHMARK
+#include "app/Benchmark.h"
+#endif
+#ifdef BASSMINT_USB_MIDI
+#include "hal/UsbMidiOut.h"
+#endif
 #include "pico/stdlib.h"
 #include <cstdio>
 
 using namespace BassMINT;
 
 int main() {
+#ifdef BASSMINT_USB_MIDI
+    // The application owns TinyUSB (CDC + MIDI); start it before stdio
+    // attaches the serial port to the CDC interface
+    UsbMidiOut::initDevice();
+#endif
+
     // Initialize Pico SDK stdio (USB serial for debugging)
     stdio_init_all();
 
+#ifdef BASSMINT_USB_MIDI
+    // Small delay to allow USB serial to connect; the stack only runs
+    // when called, so keep it running meanwhile
+    UsbMidiOut::serviceFor(500);
+#else
     // Small delay to allow USB serial to connect
     sleep_ms(500);
+#endif
 
     printf("\n");
     printf("========================================\n");
@@ -41,8 +59,14 @@ int main() {
     printf("========================================\n");
     printf("\n");
 
-    // Create and initialize application
-    App app;
+#ifdef BASSMINT_BENCHMARK
+    // Profile DSP paths before the real-time loop starts
+    Benchmark::run();
+#endif
+
+    // Create and initialize application (static storage: App holds all
+    // per-string buffers, too large for the 2 KB core0 stack)
+    static App app;
 
     if (!app.init()) {
         printf("ERROR: Failed to initialize BassMINT!\n");
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * @file SyntheticPluck.h
+ * @brief Synthetic bass plucks for the host tests
+ */
+
+#include "core/Types.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace BassMINT {
+namespace Test {
+
+// Open string frequencies in Hz (E1, A1, D2, G2)
+constexpr float OPEN_STRING_HZ[NUM_STRINGS] = {41.2034f, 55.0f, 73.4162f, 97.9989f};
+
+/**
+ * @brief Frequency of a fretted note (equal temperament)
+ */
+inline float fretFrequency(StringId string, int fret) {
+    return OPEN_STRING_HZ[static_cast<uint8_t>(string)] * std::pow(2.0f, static_cast<float>(fret) / 12.0f);
+}
+
+/**
+ * @brief Decaying four-harmonic pluck plus noise, roughly within ±0.6
+ * @param offset Start this many samples into the pluck
+ */
+inline std::vector<float> pluck(float frequencyHz, float sampleRate, size_t count,
+                                size_t offset = 0, unsigned seed = 1, float noise = 0.01f) {
+    std::mt19937 rng(seed);
+    std::normal_distribution<float> noiseDist(0.0f, noise);
+    const float twoPi = 6.28318531f;
+
+    std::vector<float> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        float t = static_cast<float>(i + offset) / sampleRate;
+        float phase = twoPi * frequencyHz * t;
+        float tone = 0.5f * std::sin(phase)
+                   + 0.25f * std::sin(2.0f * phase + 0.3f)
+                   + 0.12f * std::sin(3.0f * phase + 1.1f)
+                   + 0.06f * std::sin(4.0f * phase + 2.0f);
+        samples[i] = std::exp(-2.0f * t) * 0.8f * tone + noiseDist(rng);
+    }
+    return samples;
+}
+
+/**
+ * @brief Scale a ±1 signal to 12-bit ADC codes around mid-scale (clipped)
+ */
+inline std::vector<uint16_t> toAdc(const std::vector<float>& samples, float gain = 1.0f) {
+    std::vector<uint16_t> codes(samples.size());
+    for (size_t i = 0; i < samples.size(); ++i) {
+        long code = std::lround(2048.0f + samples[i] * gain * 2048.0f);
+        codes[i] = static_cast<uint16_t>(std::clamp(code, 0L, 4095L));
+    }
+    return codes;
+}
+
+/**
+ * @brief ADC codes back to the ±1 floats StringProcessor feeds the detectors
+ */
+inline std::vector<float> fromAdc(const std::vector<uint16_t>& codes) {
+    std::vector<float> samples(codes.size());
+    for (size_t i = 0; i < codes.size(); ++i) {
+        samples[i] = (static_cast<float>(codes[i]) - 2048.0f) / 2048.0f;
+    }
+    return samples;
+}
+
+} // namespace Test
+} // namespace BassMINT
@@ -0,0 +1,56 @@
+#pragma once
+
+/**
+ * @file TestSupport.h
+ * @brief Minimal checks for the host tests (no test framework needed)
+ *
+ * A failed CHECK prints its location and the test keeps going; main()
+ * ends with `return Test::finish("name");`, which prints a summary and
+ * returns non-zero if anything failed (ctest reads the exit code).
+ */
+
+#include <cmath>
+#include <cstdio>
+
+namespace BassMINT {
+namespace Test {
+
+inline int& failureCount() {
+    static int failures = 0;
+    return failures;
+}
+
+inline void fail(const char* file, int line, const char* expression) {
+    std::printf("FAIL %s:%d: %s\n", file, line, expression);
+    failureCount()++;
+}
+
+inline int finish(const char* name) {
+    if (failureCount() == 0) {
+        std::printf("%s: OK\n", name);
+        return 0;
+    }
+    std::printf("%s: %d check(s) failed\n", name, failureCount());
+    return 1;
+}
+
+} // namespace Test
+} // namespace BassMINT
+
+#define CHECK(condition)                                                   \
+    do {                                                                   \
+        if (!(condition)) {                                                \
+            ::BassMINT::Test::fail(__FILE__, __LINE__, #condition);        \
+        }                                                                  \
+    } while (0)
+
+#define CHECK_NEAR(actual, expected, tolerance)                            \
+    do {                                                                   \
+        if (!(std::fabs((actual) - (expected)) <= (tolerance))) {          \
+            std::printf("  %s = %g, expected %g +/- %g\n", #actual,        \
+                        static_cast<double>(actual),                       \
+                        static_cast<double>(expected),                     \
+                        static_cast<double>(tolerance));                   \
+            ::BassMINT::Test::fail(__FILE__, __LINE__, #actual);           \
+        }                                                                  \
+    } while (0)
@@ -0,0 +1,14 @@
+#pragma once
+
+/**
+ * @file gpio.h
+ * @brief Host fake of hardware/gpio.h: pin setup is accepted and ignored
+ */
+
+#include "pico/types.h"
+
+enum gpio_function {
+    GPIO_FUNC_UART = 2
+};
+
+inline void gpio_set_function(uint, gpio_function) {}
@@ -0,0 +1,35 @@
+#pragma once
+
+/**
+ * @file irq.h
+ * @brief Host fake of hardware/irq.h
+ *
+ * Handlers are only recorded; the peripheral fakes call them when their
+ * interrupt would fire.
+ */
+
+#include "pico/types.h"
+
+typedef void (*irq_handler_t)();
+
+constexpr uint FAKE_IRQ_COUNT = 32;
+
+inline irq_handler_t g_fakeIrqHandlers[FAKE_IRQ_COUNT] = {};
+inline bool g_fakeIrqEnabled[FAKE_IRQ_COUNT] = {};
+
+inline void irq_set_exclusive_handler(uint num, irq_handler_t handler) {
+    g_fakeIrqHandlers[num] = handler;
+}
+
+inline void irq_set_enabled(uint num, bool enabled) {
+    g_fakeIrqEnabled[num] = enabled;
+}
+
+/**
+ * @brief Run the handler of irq num if it is enabled
+ */
+inline void fakeIrqRaise(uint num) {
+    if (g_fakeIrqEnabled[num] && g_fakeIrqHandlers[num]) {
+        g_fakeIrqHandlers[num]();
+    }
+}
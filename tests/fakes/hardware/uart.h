@@ -0,0 +1,135 @@
+#pragma once
+
+/**
+ * @file uart.h
+ * @brief Host fake of hardware/uart.h (UART1 TX side)
+ *
+ * Models the PL011 transmit path MidiDinOut relies on: a 32-byte FIFO,
+ * the TX interrupt asserted while the FIFO is at or below its trigger
+ * level (4 bytes, the SDK default) and unmasked, and the TXFE flag.
+ *
+ * Bytes leave at the MIDI wire rate on the fake clock (pico/time.h): one
+ * byte per 320 µs (10 bits, 8-N-1, at 31250 baud), starting when it
+ * reaches an idle transmitter. Nothing shifts out on its own: a test
+ * moves the clock with fakeAdvanceUs(), or to the end of the next bytes
+ * with fakeUartDrain(). Both run the UART1 IRQ handler whenever the
+ * interrupt is due, as the hardware would between two bytes.
+ */
+
+#include "hardware/irq.h"
+#include "pico/time.h"
+#include "pico/types.h"
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+struct uart_inst_t {};
+
+struct uart_hw_t {
+    uint32_t fr;
+};
+
+#define UART_UARTFR_TXFE_BITS 0x00000080u
+#define UART1_IRQ 21
+
+inline uart_inst_t g_fakeUart1Inst;
+#define uart1 (&g_fakeUart1Inst)
+
+struct FakeUart {
+    static constexpr size_t FIFO_DEPTH = 32;
+    static constexpr size_t TX_TRIGGER_LEVEL = 4;
+    static constexpr uint64_t BYTE_US = 320;
+
+    std::deque<uint8_t> fifo;    // Front byte is the one shifting out
+    std::vector<uint8_t> wire;   // Bytes shifted out, oldest first
+    std::vector<uint64_t> wireTimesUs; // When each wire byte's stop bit ended
+    uint64_t shiftStartUs = 0;   // When the front byte started
+    bool txIrqUnmasked = false;
+    uint32_t txIrqCount = 0;     // Handler runs
+    uint32_t overruns = 0;       // Writes to a full FIFO (a driver bug)
+    uart_hw_t hw = {0};
+};
+
+inline FakeUart g_fakeUart;
+
+inline void fakeUartRaiseTx() {
+    if (g_fakeUart.txIrqUnmasked && g_fakeUart.fifo.size() <= FakeUart::TX_TRIGGER_LEVEL) {
+        g_fakeUart.txIrqCount++;
+        fakeIrqRaise(UART1_IRQ);
+    }
+}
+
+/**
+ * @brief Finish the front byte; the clock must be at its end
+ */
+inline void fakeUartShiftOne() {
+    g_fakeUart.wire.push_back(g_fakeUart.fifo.front());
+    g_fakeUart.wireTimesUs.push_back(g_fakeTimeUs);
+    g_fakeUart.fifo.pop_front();
+    g_fakeUart.shiftStartUs = g_fakeTimeUs;
+    fakeUartRaiseTx();
+}
+
+/**
+ * @brief Move the clock to the end of the next count bytes (or until the
+ * FIFO runs dry)
+ * @return Bytes shifted
+ */
+inline size_t fakeUartDrain(size_t count) {
+    size_t shifted = 0;
+    while (shifted < count && !g_fakeUart.fifo.empty()) {
+        uint64_t end = g_fakeUart.shiftStartUs + FakeUart::BYTE_US;
+        if (g_fakeTimeUs < end) {
+            g_fakeTimeUs = end;
+        }
+        fakeUartShiftOne();
+        shifted++;
+    }
+    return shifted;
+}
+
+/**
+ * @brief Move the clock by us, shifting out every byte that ends meanwhile
+ */
+inline void fakeAdvanceUs(uint64_t us) {
+    uint64_t target = g_fakeTimeUs + us;
+    while (!g_fakeUart.fifo.empty() &&
+           g_fakeUart.shiftStartUs + FakeUart::BYTE_US <= target) {
+        g_fakeTimeUs = g_fakeUart.shiftStartUs + FakeUart::BYTE_US;
+        fakeUartShiftOne();
+    }
+    g_fakeTimeUs = target;
+}
+
+inline uint uart_init(uart_inst_t*, uint baudrate) {
+    g_fakeUart = FakeUart();
+    return baudrate;
+}
+
+inline bool uart_is_writable(uart_inst_t*) {
+    return g_fakeUart.fifo.size() < FakeUart::FIFO_DEPTH;
+}
+
+inline void uart_putc_raw(uart_inst_t*, char c) {
+    if (g_fakeUart.fifo.size() >= FakeUart::FIFO_DEPTH) {
+        g_fakeUart.overruns++;
+        return;
+    }
+    if (g_fakeUart.fifo.empty()) {
+        g_fakeUart.shiftStartUs = g_fakeTimeUs; // Idle line: starts now
+    }
+    g_fakeUart.fifo.push_back(static_cast<uint8_t>(c));
+}
+
+inline void uart_set_irq_enables(uart_inst_t*, bool, bool txNeedsData) {
+    g_fakeUart.txIrqUnmasked = txNeedsData;
+}
+
+inline void uart_tx_wait_blocking(uart_inst_t*) {
+    fakeUartDrain(g_fakeUart.fifo.size());
+}
+
+inline uart_hw_t* uart_get_hw(uart_inst_t*) {
+    g_fakeUart.hw.fr = g_fakeUart.fifo.empty() ? UART_UARTFR_TXFE_BITS : 0;
+    return &g_fakeUart.hw;
+}
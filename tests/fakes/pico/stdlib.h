@@ -0,0 +1,31 @@
+#pragma once
+
+/**
+ * @file stdlib.h
+ * @brief Host fake of pico/stdlib.h
+ *
+ * A busy-wait lasts until one more byte has left the fake UART (the clock
+ * moves to the end of it), so code that spins until
+ * the transmitter drains (MidiDinOut::flush()) terminates. Spinning on an
+ * empty FIFO can never end on the fake (nothing refills it), so that
+ * aborts the test instead of hanging it.
+ */
+
+#include "hardware/uart.h"
+#include "pico/time.h"
+#include "pico/types.h"
+#include <cstdio>
+#include <cstdlib>
+
+constexpr uint32_t FAKE_MAX_IDLE_SPINS = 1000000;
+
+inline uint32_t g_fakeIdleSpins = 0;
+
+inline void tight_loop_contents() {
+    if (fakeUartDrain(1) > 0) {
+        g_fakeIdleSpins = 0;
+    } else if (++g_fakeIdleSpins > FAKE_MAX_IDLE_SPINS) {
+        std::fprintf(stderr, "tight_loop_contents(): spinning with nothing to drain\n");
+        std::abort();
+    }
+}
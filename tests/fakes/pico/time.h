@@ -0,0 +1,27 @@
+#pragma once
+
+/**
+ * @file time.h
+ * @brief Host fake of pico/time.h
+ *
+ * The clock only moves when a test sets g_fakeTimeUs.
+ */
+
+#include "pico/types.h"
+#include <cstdint>
+
+typedef uint64_t absolute_time_t;
+
+inline uint64_t g_fakeTimeUs = 0;
+
+inline uint64_t time_us_64() {
+    return g_fakeTimeUs;
+}
+
+inline absolute_time_t make_timeout_time_ms(uint32_t ms) {
+    return g_fakeTimeUs + static_cast<uint64_t>(ms) * 1000;
+}
+
+inline bool time_reached(absolute_time_t t) {
+    return g_fakeTimeUs >= t;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+/**
+ * @file types.h
+ * @brief Host fake of pico/types.h (only what the tested sources use)
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+typedef unsigned int uint;
@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * @file tusb.h
+ * @brief Host fake of TinyUSB's device MIDI API
+ *
+ * A test sets whether a host has the MIDI interface open (mounted) and
+ * reads back every event packet handed to the class driver. As in
+ * TinyUSB's MIDI driver, a write starts a transfer with the FIFO contents
+ * when none is running; packets written meanwhile wait in the FIFO until
+ * tud_task() sees the transfer complete, then leave as the next one.
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct FakeUsbMidi {
+    static constexpr size_t FIFO_PACKETS = 64; // CFG_TUD_MIDI_TX_BUFSIZE / 4
+
+    bool mounted = false;
+    bool serialOpen = false;
+    uint32_t tasks = 0;
+    std::vector<std::array<uint8_t, 4>> fifo;     // Written, not yet sent
+    std::vector<std::array<uint8_t, 4>> inFlight; // Running transfer
+    std::vector<std::array<uint8_t, 4>> sent;     // Received by the host, oldest first
+    std::vector<size_t> transfers;                // Packets per transfer started
+};
+
+inline FakeUsbMidi g_fakeUsbMidi;
+
+inline bool tusb_init() {
+    g_fakeUsbMidi = FakeUsbMidi();
+    return true;
+}
+
+inline void fakeUsbMidiStartTransfer() {
+    if (!g_fakeUsbMidi.inFlight.empty() || g_fakeUsbMidi.fifo.empty()) {
+        return;
+    }
+    g_fakeUsbMidi.inFlight.swap(g_fakeUsbMidi.fifo);
+    g_fakeUsbMidi.transfers.push_back(g_fakeUsbMidi.inFlight.size());
+}
+
+inline void tud_task() {
+    g_fakeUsbMidi.tasks++;
+    g_fakeUsbMidi.sent.insert(g_fakeUsbMidi.sent.end(),
+                              g_fakeUsbMidi.inFlight.begin(), g_fakeUsbMidi.inFlight.end());
+    g_fakeUsbMidi.inFlight.clear();
+    fakeUsbMidiStartTransfer();
+}
+
+inline bool tud_midi_mounted() {
+    return g_fakeUsbMidi.mounted;
+}
+
+inline bool tud_cdc_connected() {
+    return g_fakeUsbMidi.serialOpen;
+}
+
+inline bool tud_midi_packet_write(const uint8_t packet[4]) {
+    if (!g_fakeUsbMidi.mounted || g_fakeUsbMidi.fifo.size() >= FakeUsbMidi::FIFO_PACKETS) {
+        return false;
+    }
+    g_fakeUsbMidi.fifo.push_back({packet[0], packet[1], packet[2], packet[3]});
+    fakeUsbMidiStartTransfer();
+    return true;
+}
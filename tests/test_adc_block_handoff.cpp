@@ -0,0 +1,127 @@
+/**
+ * @file test_adc_block_handoff.cpp
+ * @brief AdcBlockHandoff against a mocked round-robin ADC and DMA pair
+ */
+
+#include "hal/AdcBlockHandoff.h"
+#include "TestSupport.h"
+#include <vector>
+
+using namespace BassMINT;
+
+using Handoff = AdcBlockHandoff<8, 4>;
+
+/**
+ * @brief Two chained DMA channels filling the handoff's buffers in turn
+ *
+ * The ADC converts channel 0..3 round robin; each sample encodes its
+ * frame and channel (frame * 4 + channel) so order and de-interleaving
+ * can be checked.
+ */
+struct MockDma {
+    Handoff& handoff;
+    size_t channel = 0;    // DMA channel filling now
+    uint16_t nextCode = 0; // Next ADC conversion result
+
+    explicit MockDma(Handoff& h) : handoff(h) {}
+
+    /**
+     * @brief Fill the current buffer and chain to the other channel
+     * @return DMA channel whose completion interrupt is now pending
+     */
+    size_t fillBlock() {
+        uint16_t* buffer = handoff.getBuffer(channel);
+        for (size_t i = 0; i < Handoff::BLOCK_SAMPLES; ++i) {
+            buffer[i] = nextCode++;
+        }
+        size_t finished = channel;
+        channel = (channel + 1) % Handoff::NUM_BUFFERS;
+        return finished;
+    }
+};
+
+static void testAlternatingBuffers() {
+    Handoff handoff;
+    MockDma dma(handoff);
+
+    CHECK(handoff.getBuffer(0) != handoff.getBuffer(1));
+    CHECK(handoff.getBuffer(2) == handoff.getBuffer(0));
+
+    uint16_t expectedFirst = 0;
+    for (int block = 0; block < 6; ++block) {
+        CHECK(handoff.getExpected() == static_cast<size_t>(block % 2));
+
+        size_t finished = dma.fillBlock();
+        const uint16_t* data = handoff.complete(finished);
+
+        // The block handed out is the buffer just filled, in order
+        CHECK(data == handoff.getBuffer(static_cast<size_t>(block % 2)));
+        CHECK(data[0] == expectedFirst);
+        CHECK(data[Handoff::BLOCK_SAMPLES - 1] == expectedFirst + Handoff::BLOCK_SAMPLES - 1);
+        expectedFirst = static_cast<uint16_t>(expectedFirst + Handoff::BLOCK_SAMPLES);
+    }
+
+    CHECK(handoff.getCompletedBlocks() == 6);
+    CHECK(handoff.getDroppedBlocks() == 0);
+}
+
+static void testLateConsumerDropsBlocks() {
+    Handoff handoff;
+    MockDma dma(handoff);
+
+    handoff.complete(dma.fillBlock()); // Buffer 0
+
+    // The IRQ for buffer 1 is missed (consumer late), buffer 0 refills
+    // and completes out of turn: one block lost, sequence resyncs
+    dma.fillBlock();
+    const uint16_t* data = handoff.complete(dma.fillBlock());
+    CHECK(data == handoff.getBuffer(0));
+    CHECK(data[0] == 2 * Handoff::BLOCK_SAMPLES);
+    CHECK(handoff.getDroppedBlocks() == 1);
+    CHECK(handoff.getExpected() == 1);
+
+    // Back in step
+    handoff.complete(dma.fillBlock());
+    handoff.complete(dma.fillBlock());
+    CHECK(handoff.getDroppedBlocks() == 1);
+
+    // Missing several in a row: every out-of-turn completion counts
+    dma.fillBlock();                   // 1, missed
+    handoff.complete(dma.fillBlock()); // 0 out of turn
+    dma.fillBlock();                   // 1, missed
+    handoff.complete(dma.fillBlock()); // 0 out of turn
+    CHECK(handoff.getDroppedBlocks() == 3);
+    CHECK(handoff.getCompletedBlocks() == 6);
+
+    // Capture restart begins at buffer 0 again
+    handoff.reset();
+    CHECK(handoff.getExpected() == 0);
+}
+
+static void testExtractChannel() {
+    Handoff handoff;
+    MockDma dma(handoff);
+    const uint16_t* block = handoff.complete(dma.fillBlock());
+
+    for (size_t channel = 0; channel < Handoff::CHANNELS; ++channel) {
+        std::vector<uint16_t> samples(Handoff::BLOCK_FRAMES + 1, 0xFFFF);
+        Handoff::extractChannel(block, Handoff::BLOCK_FRAMES, channel, samples.data());
+
+        for (size_t frame = 0; frame < Handoff::BLOCK_FRAMES; ++frame) {
+            CHECK(samples[frame] == frame * Handoff::CHANNELS + channel);
+        }
+        CHECK(samples[Handoff::BLOCK_FRAMES] == 0xFFFF); // No overrun
+    }
+
+    // Partial block: only the requested frames
+    uint16_t partial[3];
+    Handoff::extractChannel(block, 3, 2, partial);
+    CHECK(partial[0] == 2 && partial[1] == 6 && partial[2] == 10);
+}
+
+int main() {
+    testAlternatingBuffers();
+    testLateConsumerDropsBlocks();
+    testExtractChannel();
+    return Test::finish("AdcBlockHandoff");
+}
@@ -0,0 +1,195 @@
+/**
+ * @file test_cic_decimator.cpp
+ * @brief CicDecimator DC gain, rounding, frequency response and priming
+ */
+
+#include "dsp/CicDecimator.h"
+#include "TestSupport.h"
+#include <cmath>
+#include <vector>
+
+using namespace BassMINT;
+
+// As configured on the board: 4x oversampling, 3 stages, 8 kHz out
+using Decimator = CicDecimator<4, 3>;
+
+static constexpr double OUTPUT_RATE = 8000.0;
+static constexpr double INPUT_RATE = OUTPUT_RATE * Decimator::FACTOR;
+static constexpr double PI = 3.14159265358979323846;
+
+/**
+ * @brief |sin(pi f R) / (R sin(pi f))|^N with f normalized to the input rate
+ */
+static double theoreticalGain(double hz) {
+    double f = hz / INPUT_RATE;
+    double r = static_cast<double>(Decimator::FACTOR);
+    return std::pow(std::fabs(std::sin(PI * f * r) / (r * std::sin(PI * f))),
+                    static_cast<double>(Decimator::STAGES));
+}
+
+static std::vector<uint16_t> decimate(Decimator& cic, const std::vector<uint16_t>& input,
+                                      size_t blockSize) {
+    std::vector<uint16_t> output(input.size() / Decimator::FACTOR + 1);
+    size_t written = 0;
+    for (size_t pos = 0; pos < input.size(); pos += blockSize) {
+        size_t count = std::min(blockSize, input.size() - pos);
+        size_t expected = cic.getOutputSize(count);
+        size_t produced = cic.process(input.data() + pos, count, output.data() + written);
+        CHECK(produced == expected);
+        written += produced;
+    }
+    output.resize(written);
+    return output;
+}
+
+static std::vector<uint16_t> tone(double hz, double amplitude, size_t count) {
+    std::vector<uint16_t> samples(count);
+    for (size_t i = 0; i < count; ++i) {
+        samples[i] = static_cast<uint16_t>(std::lround(
+            2048.0 + amplitude * std::sin(2.0 * PI * hz * static_cast<double>(i) / INPUT_RATE)));
+    }
+    return samples;
+}
+
+// Every tone below completes whole cycles in this many outputs (10 ms)
+static constexpr size_t ANALYSIS_PERIOD = 80;
+
+/**
+ * @brief Amplitude of the hz component after skip outputs
+ */
+static double amplitudeAt(const std::vector<uint16_t>& output, size_t skip, double hz) {
+    size_t count = (output.size() - skip) / ANALYSIS_PERIOD * ANALYSIS_PERIOD;
+    double mean = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        mean += output[skip + k];
+    }
+    mean /= static_cast<double>(count);
+
+    double re = 0.0;
+    double im = 0.0;
+    for (size_t k = 0; k < count; ++k) {
+        double phase = 2.0 * PI * hz * static_cast<double>(k) / OUTPUT_RATE;
+        re += (output[skip + k] - mean) * std::cos(phase);
+        im += (output[skip + k] - mean) * std::sin(phase);
+    }
+    return 2.0 * std::sqrt(re * re + im * im) / static_cast<double>(count);
+}
+
+static void testDcGain() {
+    // Constant codes come out unchanged: gain 64 removed exactly
+    for (uint16_t code : {0, 1, 777, 2047, 2048, 4094, 4095}) {
+        Decimator cic;
+        auto output = decimate(cic, std::vector<uint16_t>(256, code), 256);
+        CHECK(output.size() == 64);
+        for (uint16_t sample : output) {
+            CHECK(sample == code);
+        }
+    }
+
+    // Input alternating 100/101 (a null at 16 kHz) averages 100.5: the
+    // shift rounds to nearest, so 101, where truncation would give 100
+    std::vector<uint16_t> input(256);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<uint16_t>(100 + (i & 1));
+    }
+    Decimator cic;
+    auto output = decimate(cic, input, input.size());
+    for (size_t k = Decimator::STAGES; k < output.size(); ++k) {
+        CHECK(output[k] == 101);
+    }
+}
+
+static void testFrequencyResponse() {
+    const double amplitude = 1500.0;
+    const size_t outputs = 2000;
+    const size_t skip = 8;
+
+    // Passband: ~0.1 dB droop at 400 Hz
+    {
+        Decimator cic;
+        auto output = decimate(cic, tone(400.0, amplitude, outputs * Decimator::FACTOR), 37);
+        double gain = amplitudeAt(output, skip, 400.0) / amplitude;
+        CHECK_NEAR(gain, theoreticalGain(400.0), 0.002);
+        CHECK_NEAR(20.0 * std::log10(gain), -0.1, 0.05);
+    }
+
+    // Near output Nyquist: 3.6 kHz is down ~8.8 dB, as the sinc^3 predicts
+    {
+        Decimator cic;
+        auto output = decimate(cic, tone(3600.0, amplitude, outputs * Decimator::FACTOR), 37);
+        double gain = amplitudeAt(output, skip, 3600.0) / amplitude;
+        CHECK_NEAR(gain, theoreticalGain(3600.0), 0.002);
+        CHECK_NEAR(20.0 * std::log10(gain), -8.8, 0.1);
+    }
+
+    // Next to the 8 kHz null: 7.9 kHz would alias to 100 Hz, but is gone
+    // below one code
+    {
+        Decimator cic;
+        auto output = decimate(cic, tone(7900.0, amplitude, outputs * Decimator::FACTOR), 37);
+        CHECK(amplitudeAt(output, skip, 100.0) < 1.0);
+        for (size_t k = skip; k < output.size(); ++k) {
+            CHECK(output[k] >= 2047 && output[k] <= 2049);
+        }
+    }
+}
+
+static void testPriming() {
+    // First output already settled on the first sample (no ramp from 0)
+    Decimator cic;
+    uint16_t block[Decimator::FACTOR] = {3000, 3000, 3000, 3000};
+    uint16_t output = 0;
+    CHECK(cic.process(block, Decimator::FACTOR, &output) == 1);
+    CHECK(output == 3000);
+
+    // reset() primes again on the next input
+    cic.reset();
+    uint16_t low[Decimator::FACTOR] = {500, 500, 500, 500};
+    CHECK(cic.process(low, Decimator::FACTOR, &output) == 1);
+    CHECK(output == 500);
+
+    // Without reset the state carries over: a step ramps through the
+    // impulse response instead of jumping
+    CHECK(cic.process(block, Decimator::FACTOR, &output) == 1);
+    CHECK(output > 500 && output < 3000);
+
+    // A partial input keeps its phase across calls
+    Decimator split;
+    CHECK(split.getOutputSize(3) == 0);
+    CHECK(split.process(block, 3, &output) == 0);
+    CHECK(split.getOutputSize(1) == 1);
+    CHECK(split.process(block, 1, &output) == 1);
+    CHECK(output == 3000);
+}
+
+static void testStride() {
+    // One channel straight out of an interleaved block matches the same
+    // channel decimated on its own, whatever the block size
+    const size_t channels = 4;
+    auto channel = tone(1000.0, 1500.0, 512);
+    std::vector<uint16_t> interleaved(channel.size() * channels, 0);
+    for (size_t i = 0; i < channel.size(); ++i) {
+        interleaved[i * channels + 2] = channel[i];
+    }
+
+    Decimator plain;
+    auto expected = decimate(plain, channel, 13);
+
+    Decimator strided;
+    std::vector<uint16_t> output(expected.size() * channels, 0);
+    size_t written = strided.process(interleaved.data() + 2, channel.size(),
+                                     output.data() + 2, channels, channels);
+    CHECK(written == expected.size());
+    for (size_t k = 0; k < written; ++k) {
+        CHECK(output[k * channels + 2] == expected[k]);
+        CHECK(output[k * channels] == 0);
+    }
+}
+
+int main() {
+    testDcGain();
+    testFrequencyResponse();
+    testPriming();
+    testStride();
+    return Test::finish("CicDecimator");
+}
@@ -0,0 +1,256 @@
+/**
+ * @file test_dual_core_pipeline.cpp
+ * @brief Single- vs dual-core pipeline (BASSMINT_DUAL_CORE) on host threads
+ *
+ * Plays strums into four StringProcessors in real time, 32-frame blocks
+ * like the ADC DMA, and runs the pipeline both ways:
+ * - single core: App::tick() order, process() then StringManager::update()
+ *   per string on one thread
+ * - dual core: a std::thread stands in for core1 and calls
+ *   StringReportQueue::processStrings(); the main thread (core0) pops the
+ *   reports into the StringManagers
+ *
+ * Both must produce the same notes. Onset -> Note On and report -> decision
+ * latency are printed for comparison (not asserted: host timing).
+ */
+
+#include "app/NoteEventBus.h"
+#include "app/StringManager.h"
+#include "app/StringReportQueue.h"
+#include "core/NoteMapping.h"
+#include "dsp/StringProcessor.h"
+#include "SyntheticPluck.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace BassMINT;
+
+static constexpr float RATE = static_cast<float>(SAMPLE_RATE_HZ);
+static constexpr size_t BLOCK_FRAMES = 32;
+static constexpr size_t PLUCK_SAMPLES = SAMPLE_RATE_HZ * 4 / 10;
+static constexpr size_t STRUM_SAMPLES = SAMPLE_RATE_HZ * 9 / 10;
+static constexpr int STRUM_FRETS[] = {0, 5, 7};
+static constexpr size_t NUM_STRUMS = sizeof(STRUM_FRETS) / sizeof(STRUM_FRETS[0]);
+
+static const StringId STRINGS[NUM_STRINGS] = {StringId::E, StringId::A, StringId::D, StringId::G};
+
+static uint32_t hostMicros() {
+    static const auto epoch = std::chrono::steady_clock::now();
+    return static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+/**
+ * @brief Records when each Note On reaches the sinks
+ */
+class NoteOnRecorder : public NoteEventSink {
+public:
+    struct Arrival {
+        StringId string;
+        uint8_t note;
+        uint32_t timeUs;
+    };
+
+    void consume(const NoteEvent* events, size_t count) override {
+        uint32_t now = hostMicros();
+        for (size_t i = 0; i < count; ++i) {
+            if (events[i].type == NoteEvent::Type::NoteOn) {
+                arrivals.push_back({events[i].string, events[i].note, now});
+            }
+        }
+    }
+
+    std::vector<Arrival> arrivals;
+};
+
+struct LatencyStats {
+    uint32_t count = 0;
+    uint64_t sumUs = 0;
+    uint32_t maxUs = 0;
+
+    void add(uint32_t us) {
+        count++;
+        sumUs += us;
+        maxUs = std::max(maxUs, us);
+    }
+
+    uint32_t averageUs() const { return count ? static_cast<uint32_t>(sumUs / count) : 0; }
+};
+
+struct PipelineResult {
+    std::vector<NoteOnRecorder::Arrival> noteOns;
+    std::vector<uint32_t> onsetUs; // Per strum: when its first block was pushed
+    LatencyStats onsetToNoteOn;
+    LatencyStats reportToDecision;
+    uint32_t reportsDropped = 0;
+    uint32_t eventsDropped = 0;
+    float maxEnvelope = 0.0f;  // From the reports, as App::printStats() reads it
+};
+
+/**
+ * @brief ADC codes per string: NUM_STRUMS strums, each a pluck then silence
+ */
+static std::array<std::vector<uint16_t>, NUM_STRINGS> makeStrums() {
+    std::array<std::vector<uint16_t>, NUM_STRINGS> codes;
+    for (size_t s = 0; s < NUM_STRINGS; ++s) {
+        for (size_t k = 0; k < NUM_STRUMS; ++k) {
+            float hz = Test::fretFrequency(STRINGS[s], STRUM_FRETS[k]);
+            auto pluck = Test::toAdc(Test::pluck(hz, RATE, PLUCK_SAMPLES, 0,
+                                                 static_cast<uint32_t>(s * NUM_STRUMS + k + 1)));
+            codes[s].insert(codes[s].end(), pluck.begin(), pluck.end());
+            codes[s].resize(codes[s].size() + STRUM_SAMPLES - PLUCK_SAMPLES, 2048);
+        }
+    }
+    return codes;
+}
+
+static PipelineResult runPipeline(bool dualCore) {
+    static const auto codes = makeStrums();
+
+    std::array<StringProcessor, NUM_STRINGS> processors = {
+        StringProcessor(StringId::E, RATE, PITCH_HOP_SIZE, PitchDetectorType::Yin),
+        StringProcessor(StringId::A, RATE, PITCH_HOP_SIZE, PitchDetectorType::Yin),
+        StringProcessor(StringId::D, RATE, PITCH_HOP_SIZE, PitchDetectorType::Yin),
+        StringProcessor(StringId::G, RATE, PITCH_HOP_SIZE, PitchDetectorType::Yin)
+    };
+    NoteBus bus;
+    std::array<StringManager, NUM_STRINGS> managers = {
+        StringManager(StringId::E, bus),
+        StringManager(StringId::A, bus),
+        StringManager(StringId::D, bus),
+        StringManager(StringId::G, bus)
+    };
+    NoteOnRecorder recorder;
+    bus.subscribe(recorder);
+
+    StringReportQueue queue;
+    std::atomic<bool> running{true};
+    PipelineResult result;
+
+    auto applyReport = [&](const StringReport& report, bool fresh) {
+        managers[static_cast<uint8_t>(report.string)].update(report);
+        result.maxEnvelope = std::max(result.maxEnvelope, report.envelope);
+        if (fresh) {
+            result.reportToDecision.add(hostMicros() - report.timestampUs);
+        }
+    };
+
+    // One pass of App::tick()
+    auto tick = [&]() {
+        if (dualCore) {
+            StringReport report;
+            while (queue.pop(report)) {
+                applyReport(report, true);
+            }
+            // Stats as App::printStats() reads them on core0
+            for (const StringProcessor& processor : processors) {
+                CHECK(processor.getBufferLevel() <= RING_BUFFER_SIZE);
+            }
+        } else {
+            for (size_t i = 0; i < NUM_STRINGS; ++i) {
+                bool fresh = processors[i].process();
+                applyReport(processors[i].getReport(hostMicros()), fresh);
+            }
+        }
+        bus.dispatch();
+    };
+
+    // Core1: DSP only
+    std::thread core1;
+    if (dualCore) {
+        core1 = std::thread([&]() {
+            while (running.load(std::memory_order_acquire)) {
+                if (queue.processStrings(processors.data(), NUM_STRINGS, hostMicros) == 0) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    const size_t total = codes[0].size();
+    const auto blockPeriod = std::chrono::microseconds(BLOCK_FRAMES * 1000000 / SAMPLE_RATE_HZ);
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t pos = 0, block = 0; pos < total; pos += BLOCK_FRAMES, ++block) {
+        // Main loop spins until the next DMA block completes
+        while (std::chrono::steady_clock::now() < start + block * blockPeriod) {
+            tick();
+            std::this_thread::yield();
+        }
+
+        // ADC block IRQ (core0 in both builds)
+        if (pos % STRUM_SAMPLES == 0) {
+            result.onsetUs.push_back(hostMicros());
+        }
+        for (size_t s = 0; s < NUM_STRINGS; ++s) {
+            processors[s].pushBlock(codes[s].data() + pos, std::min(BLOCK_FRAMES, total - pos));
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    if (core1.joinable()) {
+        core1.join();
+    }
+    tick();
+
+    result.noteOns = recorder.arrivals;
+    result.reportsDropped = queue.getDropped();
+    result.eventsDropped = bus.getDroppedEvents();
+    return result;
+}
+
+/**
+ * @brief One Note On per string per strum, on the strummed fret
+ */
+static void checkNotes(PipelineResult& result) {
+    CHECK(result.noteOns.size() == NUM_STRUMS * NUM_STRINGS);
+    CHECK(result.onsetUs.size() == NUM_STRUMS);
+    CHECK(result.eventsDropped == 0);
+    CHECK(result.maxEnvelope > 0.1f);
+
+    for (size_t s = 0; s < NUM_STRINGS; ++s) {
+        size_t strum = 0;
+        for (const auto& noteOn : result.noteOns) {
+            if (noteOn.string != STRINGS[s]) {
+                continue;
+            }
+            if (strum >= NUM_STRUMS) {
+                CHECK(strum < NUM_STRUMS);
+                break;
+            }
+            CHECK(noteOn.note == NoteMapping::fretToMidiNote(STRINGS[s], STRUM_FRETS[strum]));
+            result.onsetToNoteOn.add(noteOn.timeUs - result.onsetUs[strum]);
+            strum++;
+        }
+        CHECK(strum == NUM_STRUMS);
+    }
+}
+
+static void print(const char* name, const PipelineResult& result) {
+    printf("%-12s onset->NoteOn avg %6lu us max %6lu us | report->decision avg %5lu us "
+           "max %5lu us | reports dropped %lu\n",
+           name,
+           static_cast<unsigned long>(result.onsetToNoteOn.averageUs()),
+           static_cast<unsigned long>(result.onsetToNoteOn.maxUs),
+           static_cast<unsigned long>(result.reportToDecision.averageUs()),
+           static_cast<unsigned long>(result.reportToDecision.maxUs),
+           static_cast<unsigned long>(result.reportsDropped));
+}
+
+int main() {
+    PipelineResult single = runPipeline(false);
+    checkNotes(single);
+    print("single core", single);
+
+    PipelineResult dual = runPipeline(true);
+    checkNotes(dual);
+    print("dual core", dual);
+
+    return Test::finish("DualCorePipeline");
+}
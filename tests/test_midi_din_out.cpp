@@ -0,0 +1,344 @@
+/**
+ * @file test_midi_din_out.cpp
+ * @brief MidiTxQueue backpressure and MidiDinOut byte order on a fake UART
+ *
+ * The fake UART shifts bytes out at the 31250-baud wire rate on a fake
+ * clock, so the burst test sees the queue fill and the TX IRQ refill the
+ * FIFO as they would on the board.
+ */
+
+#include "hal/MidiDinOut.h"
+#include "hal/MidiTxQueue.h"
+#include "hardware/uart.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <vector>
+
+using namespace BassMINT;
+
+// A 10-byte fret SysEx (v1 frame)
+static const uint8_t FRET_SYSEX[10] = {0xF0, 0x7D, 0x01, 0x01, 0x00, 0x05, 0x64, 0x00, 0x00, 0xF7};
+
+static std::vector<uint8_t> popAll(MidiTxQueue<64>& queue) {
+    std::vector<uint8_t> bytes;
+    uint8_t byte;
+    while (queue.pop(byte)) {
+        bytes.push_back(byte);
+    }
+    return bytes;
+}
+
+static void testQueueOrder() {
+    MidiTxQueue<64> queue;
+    const uint8_t noteOn[3] = {0x90, 40, 100};
+    const uint8_t noteOff[3] = {0x80, 40, 64};
+
+    CHECK(queue.enqueue(noteOn, 3));
+    CHECK(queue.enqueue(FRET_SYSEX, sizeof(FRET_SYSEX)));
+    CHECK(queue.enqueue(noteOff, 3));
+    CHECK(queue.getPending() == 16);
+    CHECK(queue.getMaxPending() == 16);
+
+    std::vector<uint8_t> expected(noteOn, noteOn + 3);
+    expected.insert(expected.end(), FRET_SYSEX, FRET_SYSEX + sizeof(FRET_SYSEX));
+    expected.insert(expected.end(), noteOff, noteOff + 3);
+    CHECK(popAll(queue) == expected);
+    CHECK(queue.isEmpty());
+
+    CHECK(!queue.enqueue(nullptr, 3));
+    CHECK(!queue.enqueue(noteOn, 0));
+}
+
+static void testQueueSysExReserve() {
+    using Queue = MidiTxQueue<64>;
+    const size_t sysexNeeds = sizeof(FRET_SYSEX) + Queue::CHANNEL_RESERVE;
+    const uint8_t noteOn[3] = {0x90, 40, 100};
+
+    // One byte short of length + reserve: the SysEx is dropped whole
+    Queue queue;
+    std::vector<uint8_t> filler(Queue::CAPACITY - sysexNeeds + 1, 0x40);
+    filler[0] = 0xF0;
+    filler.back() = 0xF7;
+    CHECK(queue.enqueue(filler.data(), filler.size()));
+    size_t pending = queue.getPending();
+
+    CHECK(!queue.enqueue(FRET_SYSEX, sizeof(FRET_SYSEX)));
+    CHECK(queue.getPending() == pending);
+    CHECK(queue.getDroppedMessages() == 1);
+    CHECK(queue.getDroppedBytes() == sizeof(FRET_SYSEX));
+
+    // Channel messages still get the reserve
+    size_t notes = 0;
+    while (queue.enqueue(noteOn, 3)) {
+        notes++;
+    }
+    CHECK(notes == (Queue::CAPACITY - pending) / 3);
+    CHECK(notes * 3 >= Queue::CHANNEL_RESERVE);
+    CHECK(queue.getDroppedMessages() == 2);
+    CHECK(queue.getDroppedBytes() == sizeof(FRET_SYSEX) + 3);
+
+    // Nothing of the dropped messages reached the queue
+    auto bytes = popAll(queue);
+    CHECK(bytes.size() == filler.size() + notes * 3);
+    CHECK(std::equal(filler.begin(), filler.end(), bytes.begin()));
+
+    // Exactly length + reserve free: accepted
+    Queue exact;
+    filler.pop_back();
+    filler.back() = 0xF7;
+    CHECK(exact.enqueue(filler.data(), filler.size()));
+    CHECK(exact.enqueue(FRET_SYSEX, sizeof(FRET_SYSEX)));
+    CHECK(exact.getPending() == Queue::CAPACITY - Queue::CHANNEL_RESERVE);
+    CHECK(exact.getDroppedMessages() == 0);
+}
+
+static void testRunningStatusOnWire() {
+    MidiDinOut midi;
+    midi.init();
+    midi.setRunningStatus(true);
+
+    midi.sendNoteOn(0, 40, 100);
+    midi.sendNoteOn(0, 45, 90);               // Running status
+    midi.sendNoteOff(0, 40, 64);              // Note On velocity 0, running
+    midi.sendControlChange(1, 7, 100);        // New status
+    midi.sendControlChange(1, 7, 90);         // Running status
+    midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX)); // Cancels it
+    midi.sendControlChange(1, 7, 80);         // Status again
+    const uint8_t clock = 0xF8;
+    midi.sendMessage(&clock, 1);              // Real-time keeps it
+    midi.sendControlChange(1, 7, 70);
+
+    const std::vector<uint8_t> expected = {
+        0x90, 40, 100,
+        45, 90,
+        40, 0,
+        0xB1, 7, 100,
+        7, 90,
+        0xF0, 0x7D, 0x01, 0x01, 0x00, 0x05, 0x64, 0x00, 0x00, 0xF7,
+        0xB1, 7, 80,
+        0xF8,
+        7, 70
+    };
+
+    // Sends only queue; the FIFO was primed, nothing shifted out yet
+    CHECK(g_fakeUart.wire.empty());
+    CHECK(!midi.isTxIdle());
+
+    midi.flush();
+    CHECK(g_fakeUart.wire == expected);
+    CHECK(midi.isTxIdle());
+    CHECK(midi.getPendingBytes() == 0);
+    CHECK(midi.getDroppedMessages() == 0);
+    CHECK(g_fakeUart.overruns == 0);
+}
+
+static void testRunningStatusWireTime() {
+    // A four-string change on one channel: 8 notes, 24 bytes (7.7 ms)
+    // without running status, 17 (5.4 ms) with it
+    for (bool running : {false, true}) {
+        MidiDinOut midi;
+        midi.init();
+        midi.setRunningStatus(running);
+        uint64_t start = g_fakeTimeUs;
+
+        for (uint8_t string = 0; string < NUM_STRINGS; ++string) {
+            midi.sendNoteOff(0, static_cast<uint8_t>(40 + 5 * string), 64);
+            midi.sendNoteOn(0, static_cast<uint8_t>(42 + 5 * string), 100);
+        }
+        midi.flush();
+
+        size_t bytes = running ? 1 + 8 * 2 : 8 * 3;
+        CHECK(g_fakeUart.wire.size() == bytes);
+        CHECK(g_fakeTimeUs - start == bytes * FakeUart::BYTE_US);
+    }
+}
+
+static void testPitchBendOnWire() {
+    MidiDinOut midi;
+    midi.init();
+    midi.setRunningStatus(true);
+
+    midi.sendPitchBend(1, 0x2001);            // LSB first
+    midi.sendPitchBend(1, 0x2002);            // Running status
+    midi.sendPitchBend(1, 0xFFFF);            // 14 bits kept
+    midi.sendNoteOn(1, 40, 100);              // New status
+    midi.sendPitchBend(0x12, PITCH_BEND_CENTER); // Channel masked to 2
+
+    const std::vector<uint8_t> expected = {
+        0xE1, 0x01, 0x40,
+        0x02, 0x40,
+        0x7F, 0x7F,
+        0x91, 40, 100,
+        0xE2, 0x00, 0x40
+    };
+
+    midi.flush();
+    CHECK(g_fakeUart.wire == expected);
+    CHECK(midi.getDroppedMessages() == 0);
+}
+
+static void testIrqRefill() {
+    MidiDinOut midi;
+    midi.init();
+
+    // More than the FIFO holds: the TX IRQ has to refill it
+    std::vector<uint8_t> expected;
+    for (uint8_t i = 0; i < 40; ++i) {
+        midi.sendNoteOn(i & 0x0F, 40 + i, 100);
+        const uint8_t message[3] = {static_cast<uint8_t>(0x90 | (i & 0x0F)),
+                                    static_cast<uint8_t>(40 + i), 100};
+        expected.insert(expected.end(), message, message + 3);
+    }
+    CHECK(g_fakeUart.fifo.size() == FakeUart::FIFO_DEPTH);
+    CHECK(midi.getPendingBytes() == expected.size() - FakeUart::FIFO_DEPTH);
+    CHECK(g_fakeUart.txIrqUnmasked);
+
+    // Drain as the wire would, a byte at a time
+    while (fakeUartDrain(1) > 0) {
+    }
+
+    CHECK(g_fakeUart.wire == expected);
+    CHECK(g_fakeUart.txIrqCount > 0);
+    CHECK(!g_fakeUart.txIrqUnmasked); // Masked once the queue ran dry
+    CHECK(g_fakeUart.overruns == 0);
+    CHECK(midi.isTxIdle());
+    CHECK(midi.getMaxPendingBytes() == expected.size() - FakeUart::FIFO_DEPTH);
+}
+
+static void testBackpressureDrops() {
+    MidiDinOut midi;
+    midi.init();
+
+    // Nothing drains: SysEx fills the queue up to the channel reserve
+    std::vector<uint8_t> expected;
+    uint32_t sysexSent = 0;
+    for (int i = 0; i < 40; ++i) {
+        uint32_t dropped = midi.getDroppedMessages();
+        midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX));
+        if (midi.getDroppedMessages() == dropped) {
+            expected.insert(expected.end(), FRET_SYSEX, FRET_SYSEX + sizeof(FRET_SYSEX));
+            sysexSent++;
+        }
+    }
+    CHECK(sysexSent < 40);
+    CHECK(midi.getDroppedMessages() == 40 - sysexSent);
+    CHECK(midi.getDroppedBytes() == (40 - sysexSent) * sizeof(FRET_SYSEX));
+
+    // Note On/Off still fit in the reserve
+    for (uint8_t string = 0; string < NUM_STRINGS; ++string) {
+        const uint8_t pair[6] = {0x80, static_cast<uint8_t>(40 + string), 64,
+                                 0x90, static_cast<uint8_t>(41 + string), 100};
+        CHECK(midi.sendMessage(pair, 3));
+        CHECK(midi.sendMessage(pair + 3, 3));
+        expected.insert(expected.end(), pair, pair + 6);
+    }
+    CHECK(midi.getDroppedMessages() == 40 - sysexSent);
+
+    // On the wire: accepted messages only, every SysEx complete
+    midi.flush();
+    CHECK(g_fakeUart.wire == expected);
+    CHECK(g_fakeUart.overruns == 0);
+}
+
+static void testSendsReturnAtOnce() {
+    MidiDinOut midi;
+    midi.init();
+
+    // 40 bytes queued with no time passing: nothing waits for the wire
+    uint64_t start = g_fakeTimeUs;
+    midi.sendNoteOn(0, 40, 100);
+    midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX));
+    midi.sendNoteOff(0, 40, 64);
+    midi.sendNoteOn(1, 45, 100);
+    midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX));
+    midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX));
+    midi.sendNoteOn(2, 50, 100);
+    CHECK(g_fakeTimeUs == start);
+    CHECK(g_fakeUart.wire.empty());
+    CHECK(g_fakeUart.fifo.size() == FakeUart::FIFO_DEPTH);
+    CHECK(midi.getPendingBytes() == 42 - FakeUart::FIFO_DEPTH);
+
+    // 42 bytes on the wire 42 byte times later
+    fakeAdvanceUs(42 * FakeUart::BYTE_US);
+    CHECK(g_fakeUart.wire.size() == 42);
+    CHECK(midi.isTxIdle());
+}
+
+/**
+ * @brief Four-string changes (Note Off, Note On, fret SysEx per string: 64
+ * bytes, 20.5 ms of wire) every 10 ms, for 40 changes
+ */
+static void testWireRateBurst() {
+    using Queue = MidiDinOut::TxQueue;
+    const int changes = 40;
+    const uint64_t periodUs = 10000;
+
+    MidiDinOut midi;
+    midi.init();
+    uint64_t start = g_fakeTimeUs;
+
+    uint32_t sysexSent = 0;
+    uint32_t notesDropped = 0;
+    for (int change = 0; change < changes; ++change) {
+        for (uint8_t string = 0; string < NUM_STRINGS; ++string) {
+            uint8_t note = static_cast<uint8_t>(40 + 5 * string + (change & 7));
+            const uint8_t off[3] = {static_cast<uint8_t>(0x80 | string), note, 64};
+            const uint8_t on[3] = {static_cast<uint8_t>(0x90 | string), note, 100};
+            notesDropped += midi.sendMessage(off, 3) ? 0 : 1;
+            notesDropped += midi.sendMessage(on, 3) ? 0 : 1;
+
+            uint32_t dropped = midi.getDroppedMessages();
+            midi.sendSysEx(FRET_SYSEX, sizeof(FRET_SYSEX));
+            sysexSent += (midi.getDroppedMessages() == dropped) ? 1 : 0;
+        }
+        CHECK(midi.getPendingBytes() <= Queue::CAPACITY);
+        fakeAdvanceUs(periodUs);
+    }
+
+    // Twice what the wire carries: the queue filled up to the SysEx limit
+    // and SysEx were dropped whole, never a note
+    CHECK(notesDropped == 0);
+    CHECK(sysexSent < changes * NUM_STRINGS);
+    CHECK(midi.getDroppedMessages() == changes * NUM_STRINGS - sysexSent);
+    CHECK(midi.getDroppedBytes() == midi.getDroppedMessages() * sizeof(FRET_SYSEX));
+    CHECK(midi.getMaxPendingBytes() > Queue::CAPACITY - Queue::CHANNEL_RESERVE - sizeof(FRET_SYSEX));
+    CHECK(midi.getMaxPendingBytes() <= Queue::CAPACITY);
+
+    midi.flush();
+    CHECK(g_fakeUart.overruns == 0);
+
+    // Everything accepted went out, SysEx complete
+    size_t expectedBytes = changes * NUM_STRINGS * 6 + sysexSent * sizeof(FRET_SYSEX);
+    CHECK(g_fakeUart.wire.size() == expectedBytes);
+    uint32_t sysexOnWire = 0;
+    for (size_t i = 0; i < g_fakeUart.wire.size(); ++i) {
+        if (g_fakeUart.wire[i] == 0xF0) {
+            CHECK(i + sizeof(FRET_SYSEX) <= g_fakeUart.wire.size());
+            CHECK(std::equal(FRET_SYSEX, FRET_SYSEX + sizeof(FRET_SYSEX), g_fakeUart.wire.begin() + i));
+            sysexOnWire++;
+        }
+    }
+    CHECK(sysexOnWire == sysexSent);
+
+    // The TX IRQ kept the FIFO fed: back to back at 320 µs from the first
+    // byte to the last, never an idle gap
+    const auto& times = g_fakeUart.wireTimesUs;
+    CHECK(times.front() == start + FakeUart::BYTE_US);
+    for (size_t i = 1; i < times.size(); ++i) {
+        CHECK(times[i] - times[i - 1] == FakeUart::BYTE_US);
+    }
+    CHECK(times.back() == start + expectedBytes * FakeUart::BYTE_US);
+}
+
+int main() {
+    testQueueOrder();
+    testQueueSysExReserve();
+    testRunningStatusOnWire();
+    testRunningStatusWireTime();
+    testPitchBendOnWire();
+    testIrqRefill();
+    testBackpressureDrops();
+    testSendsReturnAtOnce();
+    testWireRateBurst();
+    return Test::finish("MidiDinOut");
+}
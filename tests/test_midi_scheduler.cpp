@@ -0,0 +1,519 @@
+/**
+ * @file test_midi_scheduler.cpp
+ * @brief MidiScheduler priorities, coalescing and wire latency on the fake UART
+ *
+ * The real MidiDinOut runs against tests/fakes: the fake UART shifts one
+ * byte out per 320 µs of fake clock (31250 baud), and isTxIdle() turns
+ * true only once its FIFO has drained, which is what service() waits for.
+ */
+
+#include "app/MidiScheduler.h"
+#include "core/NoteMapping.h"
+#include "core/SysExDecoder.h"
+#include "hal/MidiDinOut.h"
+#include "hardware/uart.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+using namespace BassMINT;
+
+static const StringId STRINGS[NUM_STRINGS] = {StringId::E, StringId::A, StringId::D, StringId::G};
+
+/**
+ * @brief One message as it left the wire
+ */
+struct WireMessage {
+    std::vector<uint8_t> bytes; // Status byte restored if running status omitted it
+    size_t offset;              // Position of its first byte on the wire
+    size_t length;              // Bytes it took on the wire
+
+    uint8_t status() const { return bytes[0]; }
+    bool isNoteOn() const { return (bytes[0] & 0xF0) == 0x90 && bytes[2] > 0; }
+    bool isNoteOff() const {
+        return (bytes[0] & 0xF0) == 0x80 || ((bytes[0] & 0xF0) == 0x90 && bytes[2] == 0);
+    }
+    bool isBend() const { return (bytes[0] & 0xF0) == 0xE0; }
+    bool isSysEx() const { return bytes[0] == 0xF0; }
+    uint16_t bend() const { return static_cast<uint16_t>(bytes[1] | (bytes[2] << 7)); }
+
+    /**
+     * @brief When its last byte left the wire
+     */
+    uint64_t endUs() const { return g_fakeUart.wireTimesUs[offset + length - 1]; }
+};
+
+/**
+ * @brief Split the wire into messages (3-byte channel messages and SysEx)
+ */
+static std::vector<WireMessage> parseWire(const std::vector<uint8_t>& wire) {
+    std::vector<WireMessage> messages;
+    uint8_t runningStatus = 0;
+    size_t i = 0;
+
+    while (i < wire.size()) {
+        WireMessage message;
+        message.offset = i;
+
+        if (wire[i] == 0xF0) {
+            while (i < wire.size() && wire[i] != 0xF7) {
+                message.bytes.push_back(wire[i++]);
+            }
+            message.bytes.push_back(wire[i++]);
+            runningStatus = 0;
+        } else {
+            if (wire[i] & 0x80) {
+                runningStatus = wire[i++];
+            }
+            CHECK(runningStatus != 0);
+            CHECK(i + 2 <= wire.size());
+            message.bytes = {runningStatus, wire[i], wire[i + 1]};
+            i += 2;
+        }
+        message.length = i - message.offset;
+        messages.push_back(message);
+    }
+    return messages;
+}
+
+/**
+ * @brief Main loop until everything is on the wire: service() each pass,
+ * one byte shifted out between passes
+ */
+static void runUntilIdle(MidiScheduler& scheduler) {
+    for (int pass = 0; pass < 100000; ++pass) {
+        scheduler.service();
+        if (fakeUartDrain(1) == 0) {
+            scheduler.service();
+            if (g_fakeUart.fifo.empty()) {
+                return;
+            }
+        }
+    }
+    CHECK(!"scheduler never went idle");
+}
+
+/**
+ * @brief A four-string change as the StringManagers send it in one tick:
+ * per string Note Off, Note On, fret SysEx
+ * @param fret Fret every string lands on (from fret - 1)
+ */
+static void strum(MidiScheduler& scheduler, int fret) {
+    for (StringId string : STRINGS) {
+        uint8_t oldNote = NoteMapping::fretToMidiNote(string, fret - 1);
+        uint8_t note = NoteMapping::fretToMidiNote(string, fret);
+
+        scheduler.sendNoteOff(0, oldNote, 64);
+        scheduler.sendNoteOn(0, note, 100);
+        scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(string, fret, note, 100));
+    }
+}
+
+static void testStrumNotesFirst() {
+    MidiDinOut midi;
+    midi.init();
+    MidiScheduler scheduler(midi);
+
+    strum(scheduler, 5);
+    CHECK(scheduler.getPendingSysEx() == NUM_STRINGS);
+
+    // Notes are on their way: no SysEx released while the UART is busy
+    scheduler.service();
+    CHECK(!midi.isTxIdle());
+    CHECK(scheduler.getPendingSysEx() == NUM_STRINGS);
+
+    runUntilIdle(scheduler);
+    CHECK(scheduler.getPendingSysEx() == 0);
+
+    auto messages = parseWire(g_fakeUart.wire);
+    CHECK(messages.size() == NUM_STRINGS * 3);
+
+    // Every Note Off/On ahead of the first SysEx
+    size_t firstSysEx = messages.size();
+    size_t noteOns = 0;
+    for (size_t i = 0; i < messages.size(); ++i) {
+        if (messages[i].isSysEx() && firstSysEx == messages.size()) {
+            firstSysEx = i;
+        }
+        if (messages[i].isNoteOn()) {
+            CHECK(i < firstSysEx);
+            CHECK(messages[i].bytes[1] == NoteMapping::fretToMidiNote(STRINGS[noteOns], 5));
+            noteOns++;
+        }
+        if (messages[i].isNoteOff()) {
+            CHECK(i < firstSysEx);
+        }
+    }
+    CHECK(noteOns == NUM_STRINGS);
+    CHECK(firstSysEx == NUM_STRINGS * 2);
+
+    // Then one version 1 SysEx per string, oldest (E) first
+    for (size_t s = 0; s < NUM_STRINGS; ++s) {
+        const WireMessage& message = messages[firstSysEx + s];
+        SysExDecoder::Frame frame;
+        CHECK(message.bytes.size() == 10);
+        CHECK(SysExDecoder::decode(message.bytes.data(), message.bytes.size(), frame));
+        CHECK(frame.version == 1);
+        CHECK(frame.updates[0].string == STRINGS[s]);
+        CHECK(frame.updates[0].fret == 5);
+    }
+
+    CHECK(midi.getDroppedMessages() == 0);
+}
+
+static void testSysExCoalescing() {
+    MidiDinOut midi;
+    midi.init();
+    MidiScheduler scheduler(midi);
+
+    // A note keeps the wire busy...
+    scheduler.sendNoteOn(0, 45, 100);
+
+    // ...while D moves twice and A once: only D's later fret is sent, in
+    // D's original place (first)
+    scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(StringId::D, 3, 41, 100));
+    scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(StringId::A, 2, 35, 100));
+    scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(StringId::D, 4, 42, 100));
+    CHECK(scheduler.getCoalescedSysEx() == 1);
+    CHECK(scheduler.getPendingSysEx() == 2);
+
+    runUntilIdle(scheduler);
+
+    auto messages = parseWire(g_fakeUart.wire);
+    CHECK(messages.size() == 3);
+    CHECK(messages[0].isNoteOn());
+
+    SysExDecoder::Frame frame;
+    CHECK(SysExDecoder::decode(messages[1].bytes.data(), messages[1].bytes.size(), frame));
+    CHECK(frame.updates[0].string == StringId::D);
+    CHECK(frame.updates[0].fret == 4);
+    CHECK(SysExDecoder::decode(messages[2].bytes.data(), messages[2].bytes.size(), frame));
+    CHECK(frame.updates[0].string == StringId::A);
+    CHECK(frame.updates[0].fret == 2);
+}
+
+static void testBendCoalescing() {
+    MidiDinOut midi;
+    midi.init();
+    MidiScheduler scheduler(midi);
+
+    // Slide on A (own channel): the note's start bend goes out at once...
+    scheduler.sendNoteBend(StringId::A, 2, 8000);
+    scheduler.sendNoteOn(2, 45, 100);
+
+    // ...then five bends while the UART is busy: only the last one leaves
+    for (uint16_t step = 1; step <= 5; ++step) {
+        scheduler.sendPitchBend(StringId::A, 2, static_cast<uint16_t>(8000 + 100 * step));
+        scheduler.service();
+    }
+    CHECK(scheduler.getCoalescedBends() == 4);
+
+    // A waiting bend goes ahead of a waiting SysEx
+    scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(StringId::D, 4, 42, 100));
+
+    runUntilIdle(scheduler);
+
+    auto messages = parseWire(g_fakeUart.wire);
+    CHECK(messages.size() == 4);
+    CHECK(messages[0].isBend() && messages[0].bend() == 8000);
+    CHECK(messages[1].isNoteOn());
+    CHECK(messages[2].isBend() && messages[2].bend() == 8500);
+    CHECK(messages[2].status() == 0xE2);
+    CHECK(messages[3].isSysEx());
+    CHECK(scheduler.getSentBends() == 2);
+
+    // A new note's start bend replaces the old note's waiting bend
+    scheduler.sendNoteOn(2, 47, 100);
+    scheduler.sendPitchBend(StringId::A, 2, 9000);
+    scheduler.sendNoteBend(StringId::A, 2, 8100);
+    runUntilIdle(scheduler);
+    messages = parseWire(g_fakeUart.wire);
+    CHECK(messages.size() == 6);
+    CHECK(messages.back().isBend() && messages.back().bend() == 8100);
+}
+
+static void testBundle() {
+    MidiDinOut midi;
+    midi.init();
+    midi.setRunningStatus(true);
+    MidiScheduler scheduler(midi);
+    CHECK(!scheduler.isSysExBundles()); // Version 1 unless asked for
+    scheduler.setSysExBundles(true);
+
+    strum(scheduler, 7);
+    runUntilIdle(scheduler);
+
+    auto messages = parseWire(g_fakeUart.wire);
+
+    // Four × (Note Off, Note On), then one 15-byte v2 frame
+    CHECK(messages.size() == NUM_STRINGS * 2 + 1);
+    for (size_t i = 0; i + 1 < messages.size(); ++i) {
+        CHECK(!messages[i].isSysEx());
+    }
+
+    const WireMessage& bundle = messages.back();
+    CHECK(bundle.isSysEx());
+    CHECK(bundle.bytes.size() == SysExEncoder::BUNDLE_MAX_SIZE);
+
+    SysExDecoder::Frame frame;
+    CHECK(SysExDecoder::decode(bundle.bytes.data(), bundle.bytes.size(), frame));
+    CHECK(frame.version == 2);
+    CHECK(frame.count == NUM_STRINGS);
+    for (size_t s = 0; s < NUM_STRINGS; ++s) {
+        CHECK(frame.updates[s].string == STRINGS[s]);
+        CHECK(frame.updates[s].fret == 7);
+        CHECK(frame.updates[s].midiNote == NoteMapping::fretToMidiNote(STRINGS[s], 7));
+    }
+
+    // 40 bytes of version 1 SysEx down to 15
+    CHECK(bundle.length == 15);
+    CHECK(midi.getDroppedMessages() == 0);
+}
+
+/**
+ * @brief Note On wire latency of one strum burst run
+ */
+struct BurstResult {
+    uint64_t maxUs = 0;
+    uint64_t sumUs = 0;
+    uint64_t maxPerStringUs[NUM_STRINGS] = {};
+    size_t noteOns = 0;
+    size_t sysexSent = 0;
+    uint32_t sysexDropped = 0;
+    size_t maxPendingBytes = 0;
+    uint32_t bendsSent = 0;
+    uint32_t vibratoBends = 0; // Offered between notes
+};
+
+/**
+ * @brief Note On latencies from the wire, sentUs holding each Note On's
+ * send time in send order
+ */
+static void measureNoteOns(const std::vector<uint64_t>& sentUs, BurstResult& result) {
+    for (const WireMessage& message : parseWire(g_fakeUart.wire)) {
+        if (message.isSysEx()) {
+            result.sysexSent++;
+        }
+        if (!message.isNoteOn()) {
+            continue;
+        }
+        // Notes are never reordered among themselves: kth on the wire is
+        // the kth sent
+        CHECK(result.noteOns < sentUs.size());
+        if (result.noteOns >= sentUs.size()) {
+            break;
+        }
+        uint64_t latency = message.endUs() - sentUs[result.noteOns];
+        uint64_t& stringMax = result.maxPerStringUs[result.noteOns % NUM_STRINGS];
+        stringMax = std::max(stringMax, latency);
+        result.maxUs = std::max(result.maxUs, latency);
+        result.sumUs += latency;
+        result.noteOns++;
+    }
+}
+
+/**
+ * @brief Worst-case strum bursts on the 31250-baud wire
+ *
+ * All four strings change note in the same loop pass, every periodUs, for
+ * strums passes; the main loop runs every 200 µs. Scheduled: through
+ * MidiScheduler. Direct: SysEx queued right behind its Note On, as before
+ * the scheduler. Latency: from the loop pass that sent a Note On until
+ * its last byte left the wire.
+ */
+static BurstResult runStrumBurst(uint64_t periodUs, int strums, bool scheduled) {
+    const uint64_t passUs = 200;
+
+    MidiDinOut midi;
+    midi.init();
+    midi.setRunningStatus(true);
+    MidiScheduler scheduler(midi);
+
+    std::vector<uint64_t> sentUs; // Per Note On, in send order
+    uint64_t start = g_fakeTimeUs;
+    uint64_t nextStrum = start;
+    int sent = 0;
+
+    while (sent < strums || !midi.isTxIdle() || scheduler.getPendingSysEx() > 0) {
+        if (sent < strums && g_fakeTimeUs >= nextStrum) {
+            int fret = 1 + (sent % 12);
+            if (scheduled) {
+                strum(scheduler, fret);
+            } else {
+                for (StringId string : STRINGS) {
+                    uint8_t note = NoteMapping::fretToMidiNote(string, fret);
+                    midi.sendNoteOff(0, NoteMapping::fretToMidiNote(string, fret - 1), 64);
+                    midi.sendNoteOn(0, note, 100);
+                    auto sysex = SysExEncoder::encode(SysExEncoder::FretSysExPayload(string, fret, note, 100));
+                    midi.sendSysEx(sysex.data(), sysex.size());
+                }
+            }
+            for (size_t s = 0; s < NUM_STRINGS; ++s) {
+                sentUs.push_back(g_fakeTimeUs);
+            }
+            sent++;
+            nextStrum += periodUs;
+        }
+        scheduler.service();
+        fakeAdvanceUs(passUs);
+    }
+
+    BurstResult result;
+    measureNoteOns(sentUs, result);
+    result.sysexDropped = midi.getDroppedMessages();
+    result.maxPendingBytes = midi.getMaxPendingBytes();
+    return result;
+}
+
+static void testStrumBurstLatency() {
+    const int strums = 200;
+
+    // A Note On waits at most for the SysEx already on the wire (10
+    // bytes) and its own strum's notes (running status: 1 + 7 × 2 + 2)
+    const uint64_t boundUs = (10 + 17) * FakeUart::BYTE_US;
+
+    std::printf("strum burst, %d strums, Note On wire latency (ms):\n", strums);
+    std::printf("  period  mode       max    avg   E/A/D/G max               SysEx sent/dropped  max queue\n");
+
+    for (uint64_t periodUs : {100000u, 15000u, 8000u}) {
+        BurstResult direct = runStrumBurst(periodUs, strums, false);
+        BurstResult scheduled = runStrumBurst(periodUs, strums, true);
+
+        for (const BurstResult* result : {&direct, &scheduled}) {
+            std::printf("  %3u ms  %-9s %5.1f  %5.1f   %4.1f/%4.1f/%4.1f/%4.1f   %4zu/%-4u           %3zu B\n",
+                        static_cast<unsigned>(periodUs / 1000),
+                        result == &direct ? "direct" : "scheduled",
+                        result->maxUs / 1000.0,
+                        result->noteOns ? result->sumUs / 1000.0 / result->noteOns : 0.0,
+                        result->maxPerStringUs[0] / 1000.0, result->maxPerStringUs[1] / 1000.0,
+                        result->maxPerStringUs[2] / 1000.0, result->maxPerStringUs[3] / 1000.0,
+                        result->sysexSent, result->sysexDropped, result->maxPendingBytes);
+
+            // No note lost either way
+            CHECK(result->noteOns == static_cast<size_t>(strums) * NUM_STRINGS);
+        }
+
+        // Scheduled: bounded whatever the strum rate, SysEx never dropped
+        // (coalesced in their slots instead), at most one in the queue
+        CHECK(scheduled.maxUs <= boundUs);
+        CHECK(scheduled.sysexDropped == 0);
+        CHECK(scheduled.maxPendingBytes <= 10 + 17);
+
+        // Direct: the last string's Note On waits behind the others' SysEx
+        CHECK(direct.maxPerStringUs[NUM_STRINGS - 1] > direct.maxPerStringUs[0]);
+        CHECK(direct.maxUs > boundUs);
+    }
+}
+
+/**
+ * @brief Strum bursts in PerStringChannel mode, with vibrato
+ *
+ * As runStrumBurst(), but each string on its own channel: Note Off, the
+ * new note's start bend, Note On and the fret SysEx per string, and a
+ * vibrato bend per string every 16 ms pitch hop in between.
+ */
+static BurstResult runBendBurst(uint64_t periodUs, int strums) {
+    const uint64_t passUs = 200;
+    const uint64_t hopUs = 16000;
+
+    MidiDinOut midi;
+    midi.init();
+    midi.setRunningStatus(true);
+    MidiScheduler scheduler(midi);
+
+    BurstResult result;
+    std::vector<uint64_t> sentUs;
+    uint64_t start = g_fakeTimeUs;
+    uint64_t nextStrum = start;
+    uint64_t nextHop = start + hopUs;
+    int sent = 0;
+
+    while (sent < strums || !midi.isTxIdle() || scheduler.getPendingSysEx() > 0) {
+        if (sent < strums && g_fakeTimeUs >= nextStrum) {
+            int fret = 1 + (sent % 12);
+            for (size_t s = 0; s < NUM_STRINGS; ++s) {
+                uint8_t channel = static_cast<uint8_t>(1 + s);
+                uint8_t note = NoteMapping::fretToMidiNote(STRINGS[s], fret);
+                scheduler.sendNoteOff(channel, NoteMapping::fretToMidiNote(STRINGS[s], fret - 1), 64);
+                scheduler.sendNoteBend(STRINGS[s], channel, static_cast<uint16_t>(PITCH_BEND_CENTER - 40));
+                scheduler.sendNoteOn(channel, note, 100);
+                scheduler.sendFretSysEx(SysExEncoder::FretSysExPayload(STRINGS[s], fret, note, 100));
+                sentUs.push_back(g_fakeTimeUs);
+            }
+            sent++;
+            nextStrum += periodUs;
+        }
+        if (sent < strums && g_fakeTimeUs >= nextHop) {
+            // ±100 cents at 48 semitones full scale: ±171
+            int step = static_cast<int>((g_fakeTimeUs / hopUs) % 4);
+            uint16_t value = static_cast<uint16_t>(PITCH_BEND_CENTER + (step - 2) * 85);
+            for (size_t s = 0; s < NUM_STRINGS; ++s) {
+                scheduler.sendPitchBend(STRINGS[s], static_cast<uint8_t>(1 + s), value);
+                result.vibratoBends++;
+            }
+            nextHop += hopUs;
+        }
+        scheduler.service();
+        fakeAdvanceUs(passUs);
+    }
+
+    measureNoteOns(sentUs, result);
+    result.sysexDropped = midi.getDroppedMessages();
+    result.maxPendingBytes = midi.getMaxPendingBytes();
+    result.bendsSent = scheduler.getSentBends();
+    return result;
+}
+
+static void testBendBurstLatency() {
+    const int strums = 200;
+
+    // Ahead of a Note On: at most one bend per string (12 bytes, more than
+    // a SysEx) already on the wire, and its own strum's Note Off, start
+    // bend and Note On per string (own channels: 9 bytes each)
+    const uint64_t boundUs = (12 + 9 * NUM_STRINGS) * FakeUart::BYTE_US;
+
+    std::printf("strum burst with bends, %d strums, per-string channels, Note On wire latency (ms):\n",
+                strums);
+    std::printf("  period   max    avg   E/A/D/G max               vibrato sent/offered  SysEx sent\n");
+
+    // A strum alone takes 36 bytes (11.5 ms) here: faster than 12 ms the
+    // notes themselves overrun the wire
+    for (uint64_t periodUs : {100000u, 15000u, 12000u}) {
+        BurstResult result = runBendBurst(periodUs, strums);
+        std::printf("  %3u ms  %5.1f  %5.1f   %4.1f/%4.1f/%4.1f/%4.1f   %5u/%-5u           %4zu\n",
+                    static_cast<unsigned>(periodUs / 1000), result.maxUs / 1000.0,
+                    result.noteOns ? result.sumUs / 1000.0 / result.noteOns : 0.0,
+                    result.maxPerStringUs[0] / 1000.0, result.maxPerStringUs[1] / 1000.0,
+                    result.maxPerStringUs[2] / 1000.0, result.maxPerStringUs[3] / 1000.0,
+                    result.bendsSent - strums * NUM_STRINGS, result.vibratoBends, result.sysexSent);
+
+        // Bends never delay a note beyond the bound, nothing is dropped
+        CHECK(result.noteOns == static_cast<size_t>(strums) * NUM_STRINGS);
+        CHECK(result.maxUs <= boundUs);
+        CHECK(result.sysexDropped == 0);
+
+        // Every start bend goes out with its note; vibrato bends thin out
+        // as the strums take the wire
+        uint32_t startBends = static_cast<uint32_t>(strums) * NUM_STRINGS;
+        CHECK(result.bendsSent >= startBends);
+        uint32_t vibratoSent = result.bendsSent - startBends;
+        CHECK(vibratoSent <= result.vibratoBends);
+        if (periodUs == 100000u) {
+            CHECK(vibratoSent * 100 >= result.vibratoBends * 95);
+        }
+        if (periodUs == 12000u) {
+            CHECK(vibratoSent * 2 < result.vibratoBends);
+        }
+    }
+}
+
+int main() {
+    testStrumNotesFirst();
+    testSysExCoalescing();
+    testBendCoalescing();
+    testBundle();
+    testStrumBurstLatency();
+    testBendBurstLatency();
+    return Test::finish("MidiScheduler");
+}
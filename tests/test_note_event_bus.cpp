@@ -0,0 +1,259 @@
+/**
+ * @file test_note_event_bus.cpp
+ * @brief NoteEventBus fan-out to the recorder, trace and DIN sinks
+ *
+ * MemoryEventSink and StreamEventSink subscribed side by side: every sink
+ * sees every event in order, a full queue drops and counts the newest,
+ * a wrapped queue arrives as two runs, and each dispatch ends with one
+ * endBatch() per sink. MidiScheduler as a sink on the fake UART turns the
+ * events into MIDI in their priority order.
+ */
+
+#include "app/MemoryEventSink.h"
+#include "app/MidiScheduler.h"
+#include "app/NoteEventBus.h"
+#include "app/StreamEventSink.h"
+#include "hal/MidiDinOut.h"
+#include "hardware/uart.h"
+#include "TestSupport.h"
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace BassMINT;
+
+/**
+ * @brief Counts the runs and batches the bus hands over
+ */
+class RunCounter : public NoteEventSink {
+public:
+    void consume(const NoteEvent*, size_t count) override {
+        runs.push_back(count);
+    }
+
+    void endBatch() override {
+        batches++;
+    }
+
+    std::vector<size_t> runs;
+    uint32_t batches = 0;
+};
+
+/**
+ * @brief A StreamEventSink on a memory stream, text readable after endBatch()
+ */
+struct Trace {
+    char* text = nullptr;
+    size_t length = 0;
+    FILE* stream = open_memstream(&text, &length);
+    StreamEventSink sink{stream};
+
+    ~Trace() {
+        fclose(stream);
+        free(text);
+    }
+
+    std::string str() const { return std::string(text ? text : "", length); }
+
+    size_t lines() const {
+        std::string s = str();
+        size_t count = 0;
+        for (char c : s) {
+            count += (c == '\n');
+        }
+        return count;
+    }
+};
+
+static NoteEvent numbered(uint32_t n) {
+    return NoteEvent::noteOn(StringId::E, 0, static_cast<uint8_t>(n & 0x7F), 100, n);
+}
+
+static void testFanOutInOrder() {
+    NoteBus bus;
+    MemoryEventSink<16> memory;
+    Trace trace;
+    CHECK(bus.subscribe(memory));
+    CHECK(bus.subscribe(trace.sink));
+
+    CHECK(bus.publish(NoteEvent::mpeConfiguration(MPE_MASTER_CHANNEL, NUM_STRINGS)));
+    CHECK(bus.publish(NoteEvent::noteOff(StringId::A, 1, 35, 64, 1000)));
+    CHECK(bus.publish(NoteEvent::pitchBend(StringId::A, 1, 8200, true, 1000)));
+    CHECK(bus.publish(NoteEvent::noteOn(StringId::A, 1, 38, 100, 1000)));
+    CHECK(bus.publish(NoteEvent::fretChange(StringId::A, 1, 5, 38, 100, 1000)));
+    CHECK(bus.publish(NoteEvent::pitchBend(StringId::A, 1, 8250, false, 17000)));
+    CHECK(bus.getPending() == 6);
+
+    CHECK(bus.dispatch() == 6);
+    CHECK(bus.getPending() == 0);
+
+    // Recorder: the events as published
+    CHECK(memory.size() == 6);
+    CHECK(memory[0].type == NoteEvent::Type::MpeConfiguration);
+    CHECK(memory[0].memberChannels == NUM_STRINGS);
+    CHECK(memory[2].type == NoteEvent::Type::PitchBend && memory[2].noteStart);
+    CHECK(memory[3].type == NoteEvent::Type::NoteOn && memory[3].note == 38);
+    CHECK(memory[4].type == NoteEvent::Type::Fret && memory[4].fret == 5);
+    CHECK(memory[5].bend == 8250 && !memory[5].noteStart);
+    CHECK(memory.getBatches() == 1);
+
+    // Trace: one line each, flushed by endBatch()
+    const char* expected =
+        "0 mpe  ch1 members=4\n"
+        "1000 off  A ch2 note=35 vel=64\n"
+        "1000 bend A ch2 8200 start\n"
+        "1000 on   A ch2 note=38 vel=100\n"
+        "1000 fret A ch2 fret=5 note=38 vel=100\n"
+        "17000 bend A ch2 8250\n";
+    CHECK(trace.str() == expected);
+    CHECK(trace.sink.getWrittenEvents() == 6);
+
+    // An empty pass still ends the batch
+    CHECK(bus.dispatch() == 0);
+    CHECK(memory.getBatches() == 2);
+    CHECK(memory.size() == 6);
+}
+
+static void testDropCounting() {
+    NoteBus bus;
+    MemoryEventSink<16> memory;
+    RunCounter counter;
+    bus.subscribe(memory);
+    bus.subscribe(counter);
+
+    // Dispatch stalled: the queue keeps the oldest CAPACITY, drops the rest
+    for (uint32_t n = 0; n < NoteBus::CAPACITY + 3; ++n) {
+        CHECK(bus.publish(numbered(n)) == (n < NoteBus::CAPACITY));
+    }
+    CHECK(bus.getDroppedEvents() == 3);
+    CHECK(bus.getPending() == NoteBus::CAPACITY);
+
+    // The recorder keeps its first 16 and counts the rest separately
+    CHECK(bus.dispatch() == NoteBus::CAPACITY);
+    CHECK(memory.size() == 16);
+    CHECK(memory.getOverflow() == NoteBus::CAPACITY - 16);
+    CHECK(memory[15].timestampUs == 15);
+    CHECK(counter.runs == std::vector<size_t>({NoteBus::CAPACITY}));
+
+    // Room again once dispatched
+    CHECK(bus.publish(numbered(100)));
+    CHECK(bus.getDroppedEvents() == 3);
+
+    memory.clear();
+    CHECK(memory.size() == 0 && memory.getOverflow() == 0 && memory.getBatches() == 0);
+}
+
+static void testWrappedRuns() {
+    NoteBus bus;
+    MemoryEventSink<NoteBus::CAPACITY> memory;
+    RunCounter counter;
+    Trace trace;
+    bus.subscribe(memory);
+    bus.subscribe(counter);
+    bus.subscribe(trace.sink);
+
+    // Move the ring 40 events in, then queue 40 more across its end
+    for (uint32_t n = 0; n < 40; ++n) {
+        bus.publish(numbered(n));
+    }
+    bus.dispatch();
+    memory.clear();
+    counter.runs.clear();
+
+    for (uint32_t n = 40; n < 80; ++n) {
+        bus.publish(numbered(n));
+    }
+    CHECK(bus.dispatch() == 40);
+
+    // Two runs, in place, still in publish order for every sink
+    CHECK(counter.runs == std::vector<size_t>({NoteBus::CAPACITY - 40, 80 - NoteBus::CAPACITY}));
+    CHECK(counter.batches == 2);
+    CHECK(memory.size() == 40);
+    for (size_t i = 0; i < memory.size(); ++i) {
+        CHECK(memory[i].timestampUs == 40 + i);
+    }
+
+    // 80 lines through a 512-byte buffer: written in pieces, none lost
+    CHECK(trace.sink.getWrittenEvents() == 80);
+    CHECK(trace.lines() == 80);
+    CHECK(trace.str().find("79 on   E ch1 note=79 vel=100\n") != std::string::npos);
+}
+
+static void testSubscribeLimit() {
+    NoteBus bus;
+    RunCounter sinks[NoteBus::MAX_SINKS + 1];
+    for (size_t i = 0; i < NoteBus::MAX_SINKS; ++i) {
+        CHECK(bus.subscribe(sinks[i]));
+    }
+    CHECK(!bus.subscribe(sinks[NoteBus::MAX_SINKS]));
+
+    bus.publish(numbered(1));
+    bus.dispatch();
+    for (size_t i = 0; i < NoteBus::MAX_SINKS; ++i) {
+        CHECK(sinks[i].runs.size() == 1 && sinks[i].batches == 1);
+    }
+    CHECK(sinks[NoteBus::MAX_SINKS].runs.empty());
+}
+
+static void testSchedulerSink() {
+    MidiDinOut midi;
+    midi.init();
+    MidiScheduler scheduler(midi);
+    MemoryEventSink<16> memory;
+    NoteBus bus;
+    bus.subscribe(scheduler);
+    bus.subscribe(memory);
+
+    // One StringManager tick in MPE mode: fret SysEx and a vibrato bend
+    // published ahead of the note that matters
+    bus.publish(NoteEvent::mpeConfiguration(MPE_MASTER_CHANNEL, NUM_STRINGS));
+    bus.publish(NoteEvent::fretChange(StringId::D, 3, 7, 45, 90, 0));
+    bus.publish(NoteEvent::pitchBend(StringId::G, 4, 8000, false, 0));
+    bus.publish(NoteEvent::pitchBend(StringId::D, 3, 8300, true, 0));
+    bus.publish(NoteEvent::noteOn(StringId::D, 3, 45, 90, 0));
+    bus.dispatch();
+
+    for (int pass = 0; pass < 1000 && !(midi.isTxIdle() && scheduler.getPendingSysEx() == 0); ++pass) {
+        scheduler.service();
+        fakeUartDrain(1);
+    }
+    midi.flush();
+
+    // Configuration, start bend and note at once; the vibrato bend, then
+    // the SysEx once the wire is free
+    std::vector<uint8_t> expected = {
+        0xB0, 101, 0, 0xB0, 100, 6, 0xB0, 6, NUM_STRINGS, 0xB0, 101, 127, 0xB0, 100, 127,
+        0xE3, 8300 & 0x7F, 8300 >> 7,
+        0x93, 45, 90,
+        0xE4, 8000 & 0x7F, 8000 >> 7
+    };
+    auto sysEx = SysExEncoder::encode(SysExEncoder::FretSysExPayload(StringId::D, 7, 45, 90));
+    expected.insert(expected.end(), sysEx.begin(), sysEx.end());
+    CHECK(g_fakeUart.wire == expected);
+    CHECK(midi.getDroppedMessages() == 0);
+
+    // The recorder saw the same events, in publish order
+    CHECK(memory.size() == 5);
+    CHECK(memory[1].type == NoteEvent::Type::Fret);
+
+    // Fret SysEx off: the Fret event is ignored on DIN only
+    scheduler.setFretSysEx(false);
+    size_t before = g_fakeUart.wire.size();
+    bus.publish(NoteEvent::fretChange(StringId::D, 3, 8, 46, 90, 0));
+    bus.dispatch();
+    scheduler.service();
+    midi.flush();
+    CHECK(g_fakeUart.wire.size() == before);
+    CHECK(scheduler.getPendingSysEx() == 0);
+    CHECK(memory.size() == 6);
+}
+
+int main() {
+    testFanOutInOrder();
+    testDropCounting();
+    testWrappedRuns();
+    testSubscribeLimit();
+    testSchedulerSink();
+    return Test::finish("NoteEventBus");
+}
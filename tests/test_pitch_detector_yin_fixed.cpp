@@ -0,0 +1,101 @@
+/**
+ * @file test_pitch_detector_yin_fixed.cpp
+ * @brief Q15 PitchDetectorYinFixed against the float PitchDetectorYin
+ *
+ * Both detectors see the same 12-bit ADC codes (the float one after the
+ * StringProcessor scaling) and must agree on valid/invalid and, when
+ * valid, on frequency within a fraction of a cent.
+ */
+
+#include "dsp/PitchDetectorYin.h"
+#include "dsp/PitchDetectorYinFixed.h"
+#include "SyntheticPluck.h"
+#include "TestSupport.h"
+#include <cmath>
+
+using namespace BassMINT;
+
+static constexpr float RATE = 8000.0f;
+static constexpr size_t WINDOW = 1024;
+static constexpr double MAX_CENTS = 1.0;
+
+static double centsBetween(float a, float b) {
+    return 1200.0 * std::log2(static_cast<double>(a) / static_cast<double>(b));
+}
+
+static void compare(const std::vector<uint16_t>& codes, float expectedHz) {
+    static PitchDetectorYin floatYin(RATE, WINDOW, 30.0f, 400.0f,
+                                     PitchDetectorYin::DifferenceMethod::Direct);
+    static PitchDetectorYinFixed fixedYin(static_cast<uint32_t>(RATE), WINDOW, 30.0f, 400.0f);
+
+    std::vector<float> samples = Test::fromAdc(codes);
+    PitchEstimate reference = floatYin.estimate(samples.data(), WINDOW, 0);
+    PitchEstimate fixed = fixedYin.estimate(codes.data(), WINDOW);
+
+    CHECK(reference.isValid() == fixed.isValid());
+
+    if (expectedHz > 0.0f) {
+        CHECK(fixed.isValid());
+        if (reference.isValid() && fixed.isValid()) {
+            CHECK_NEAR(centsBetween(fixed.frequencyHz, reference.frequencyHz), 0.0, MAX_CENTS);
+            CHECK_NEAR(centsBetween(fixed.frequencyHz, expectedHz), 0.0, 20.0);
+            CHECK_NEAR(fixed.confidence, reference.confidence, 0.001f);
+        }
+    }
+}
+
+static void testPlucksAgree() {
+    const StringId strings[] = {StringId::E, StringId::A, StringId::D, StringId::G};
+    const int frets[] = {0, 12};
+    const float gains[] = {1.0f, 0.2f, 0.05f};
+
+    for (StringId string : strings) {
+        for (int fret : frets) {
+            float hz = Test::fretFrequency(string, fret);
+            for (float gain : gains) {
+                for (unsigned seed = 1; seed <= 3; ++seed) {
+                    auto pluck = Test::pluck(hz, RATE, WINDOW, seed * 300, seed);
+                    compare(Test::toAdc(pluck, gain), hz);
+                }
+            }
+        }
+    }
+}
+
+static void testFullScaleHeadroom() {
+    // Rail-to-rail square wave: every delta across an edge is 4095, the
+    // largest square any 256-sample partial sum (ACCUM_CHUNK) or the
+    // >> DIFF_SHIFT store can see. An overflow would wreck d(tau).
+    const float hz = Test::fretFrequency(StringId::A, 0);
+    std::vector<uint16_t> codes(WINDOW);
+    for (size_t i = 0; i < WINDOW; ++i) {
+        float phase = std::fmod(static_cast<float>(i) * hz / RATE, 1.0f);
+        codes[i] = phase < 0.5f ? 4095 : 0;
+    }
+    compare(codes, hz);
+
+    // Clipped pluck (gain 3): flat tops at both rails
+    compare(Test::toAdc(Test::pluck(Test::fretFrequency(StringId::E, 5), RATE, WINDOW), 3.0f),
+            Test::fretFrequency(StringId::E, 5));
+}
+
+static void testInvalidAgree() {
+    // Silence and broadband noise: neither detector may report a pitch
+    std::vector<uint16_t> silence(WINDOW, 2048);
+    compare(silence, 0.0f);
+
+    std::mt19937 rng(11);
+    std::uniform_real_distribution<float> white(-0.5f, 0.5f);
+    std::vector<float> noise(WINDOW);
+    for (float& sample : noise) {
+        sample = white(rng);
+    }
+    compare(Test::toAdc(noise), 0.0f);
+}
+
+int main() {
+    testPlucksAgree();
+    testFullScaleHeadroom();
+    testInvalidAgree();
+    return Test::finish("PitchDetectorYinFixed");
+}
@@ -0,0 +1,139 @@
+/**
+ * @file test_spsc_ring_buffer.cpp
+ * @brief SpscRingBuffer: block semantics, then a two-thread stress run
+ *
+ * Built with -fsanitize=thread (tests/CMakeLists.txt), so any missing
+ * acquire/release between producer and consumer shows up as a data race
+ * on the sample storage, on top of the sequence checks.
+ */
+
+#include "dsp/SpscRingBuffer.h"
+#include "TestSupport.h"
+#include <algorithm>
+#include <thread>
+
+using namespace BassMINT;
+
+static void testSpansAcrossWrap() {
+    SpscRingBuffer<uint16_t, 8> ring;
+    uint16_t values[8] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    CHECK(ring.pushBlock(values, 6) == 6);
+    ring.consume(ring.readSpans(5).size()); // Read index now 5
+
+    // 6 more: 3 at the end of the storage, 3 wrapped to the start
+    CHECK(ring.pushBlock(values, 8) == 7); // One slot left after 1 unread: 7 fit
+    CHECK(ring.getFree() == 0);
+    CHECK(!ring.push(99));
+
+    auto spans = ring.readSpans(8);
+    CHECK(spans.size() == 8);
+    CHECK(spans.firstSize == 3);  // Slots 5, 6, 7
+    CHECK(spans.secondSize == 5); // Slots 0 .. 4
+    CHECK(spans.first[0] == 5);   // Last of the first block
+    CHECK(spans.first[1] == 0 && spans.first[2] == 1);
+    CHECK(spans.second[0] == 2 && spans.second[4] == 6);
+
+    // Nothing is released until consume()
+    CHECK(ring.getAvailable() == 8);
+    ring.consume(3);
+    CHECK(ring.getAvailable() == 5);
+
+    uint16_t out[8];
+    CHECK(ring.read(out, 8) == 5);
+    CHECK(out[0] == 2 && out[4] == 6);
+    CHECK(ring.isEmpty());
+    CHECK(ring.readSpans(4).size() == 0);
+}
+
+/**
+ * @brief Producer and consumer threads over a small ring (many wraps)
+ *
+ * The producer mixes push() and pushBlock() of varying sizes, the
+ * consumer mixes pop(), read() and readSpans()/consume(); values are a
+ * running sequence, so any lost, duplicated or torn sample breaks it.
+ */
+static void testTwoThreadSequence() {
+    constexpr uint32_t TOTAL = 1000000;
+    SpscRingBuffer<uint32_t, 64> ring;
+
+    std::thread producer([&ring] {
+        uint32_t block[13];
+        uint32_t next = 0;
+        uint32_t step = 0;
+        while (next < TOTAL) {
+            size_t pushed;
+            if (step++ % 4 == 0) {
+                pushed = ring.push(next) ? 1 : 0;
+            } else {
+                size_t count = std::min<uint32_t>(1 + step % 13, TOTAL - next);
+                for (size_t i = 0; i < count; ++i) {
+                    block[i] = next + static_cast<uint32_t>(i);
+                }
+                pushed = ring.pushBlock(block, count);
+            }
+            next += static_cast<uint32_t>(pushed);
+            // Full, or every few blocks so a single-CPU host interleaves
+            // the threads at varying fill levels (reads then cross the end
+            // of the storage)
+            if (pushed == 0 || step % 7 == 0) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    uint32_t expected = 0;
+    uint32_t breaks = 0;
+    uint32_t wrappedReads = 0;
+    uint32_t step = 0;
+    uint32_t out[7];
+
+    while (expected < TOTAL) {
+        uint32_t before = expected;
+
+        switch (step++ % 3) {
+            case 0: {
+                uint32_t value;
+                if (ring.pop(value)) {
+                    breaks += (value != expected++);
+                }
+                break;
+            }
+            case 1: {
+                size_t count = ring.read(out, 7);
+                for (size_t i = 0; i < count; ++i) {
+                    breaks += (out[i] != expected++);
+                }
+                break;
+            }
+            default: {
+                auto spans = ring.readSpans(1 + step % 40);
+                for (size_t i = 0; i < spans.firstSize; ++i) {
+                    breaks += (spans.first[i] != expected++);
+                }
+                for (size_t i = 0; i < spans.secondSize; ++i) {
+                    breaks += (spans.second[i] != expected++);
+                }
+                wrappedReads += (spans.secondSize > 0);
+                ring.consume(spans.size());
+                break;
+            }
+        }
+
+        if (expected == before) {
+            std::this_thread::yield(); // Empty: let the producer run
+        }
+    }
+
+    producer.join();
+
+    CHECK(breaks == 0);
+    CHECK(wrappedReads > 0); // The wrap path was exercised
+    CHECK(ring.isEmpty());
+}
+
+int main() {
+    testSpansAcrossWrap();
+    testTwoThreadSequence();
+    return Test::finish("SpscRingBuffer");
+}
@@ -0,0 +1,91 @@
+/**
+ * @file test_string_processor.cpp
+ * @brief StringProcessor states, pitch and re-attack on synthetic plucks
+ */
+
+#include "dsp/StringProcessor.h"
+#include "SyntheticPluck.h"
+#include "TestSupport.h"
+#include <cmath>
+
+using namespace BassMINT;
+
+static constexpr float RATE = static_cast<float>(SAMPLE_RATE_HZ);
+
+static double centsBetween(float a, float b) {
+    return 1200.0 * std::log2(static_cast<double>(a) / static_cast<double>(b));
+}
+
+/**
+ * @brief Feed samples one hop at a time, as the main loop would
+ * @return Pitch estimates in order (one per completed hop while active)
+ */
+static std::vector<PitchEstimate> feed(StringProcessor& processor, const std::vector<uint16_t>& codes) {
+    std::vector<PitchEstimate> estimates;
+    size_t hop = processor.getHopSize();
+    for (size_t pos = 0; pos < codes.size(); pos += hop) {
+        size_t count = std::min(hop, codes.size() - pos);
+        CHECK(processor.pushBlock(codes.data() + pos, count) == count);
+        processor.process();
+        estimates.push_back(processor.getLatestPitch());
+    }
+    return estimates;
+}
+
+static void testSinglePluck() {
+    const StringId strings[] = {StringId::E, StringId::A, StringId::D, StringId::G};
+
+    for (StringId string : strings) {
+        StringProcessor processor(string, RATE);
+        float hz = Test::fretFrequency(string, 5);
+
+        auto estimates = feed(processor, Test::toAdc(Test::pluck(hz, RATE, SAMPLE_RATE_HZ / 2,
+                                                                 0, 3, 0.03f)));
+
+        CHECK(processor.isActive());
+        CHECK(processor.getReattacks() == 0); // Plain decay is not a re-attack
+        CHECK(estimates.back().isValid());
+        CHECK_NEAR(centsBetween(estimates.back().frequencyHz, hz), 0.0, 10.0);
+
+        // Silence: release, then idle with the pitch cleared
+        feed(processor, std::vector<uint16_t>(SAMPLE_RATE_HZ, 2048));
+        CHECK(processor.getState() == StringState::Idle);
+        CHECK(!processor.getLatestPitch().isValid());
+    }
+}
+
+static void testReattackWhileActive() {
+    // Fret 12, then open string re-plucked before the first one decays
+    // below the release threshold: the gate never closes
+    StringProcessor processor(StringId::A, RATE);
+    float high = Test::fretFrequency(StringId::A, 12);
+    float low = Test::fretFrequency(StringId::A, 0);
+
+    auto first = Test::pluck(high, RATE, SAMPLE_RATE_HZ * 3 / 10);
+    for (float& sample : first) {
+        sample *= 0.5f;
+    }
+    feed(processor, Test::toAdc(first));
+    CHECK(processor.isActive());
+    CHECK(processor.getReattacks() == 0);
+
+    size_t hop = processor.getHopSize();
+    size_t windowHops = (processor.getGeometry().windowSize + hop - 1) / hop;
+    auto estimates = feed(processor, Test::toAdc(Test::pluck(low, RATE, SAMPLE_RATE_HZ / 2)));
+
+    CHECK(processor.isActive());
+    CHECK(processor.getReattacks() == 1);
+
+    // As soon as the window holds only the new note, its pitch is reported
+    // (no tracked fret 12 lag carried over)
+    for (size_t i = windowHops; i < estimates.size(); ++i) {
+        CHECK(estimates[i].isValid());
+        CHECK_NEAR(centsBetween(estimates[i].frequencyHz, low), 0.0, 10.0);
+    }
+}
+
+int main() {
+    testSinglePluck();
+    testReattackWhileActive();
+    return Test::finish("StringProcessor");
+}
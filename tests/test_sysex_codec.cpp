@@ -0,0 +1,203 @@
+/**
+ * @file test_sysex_codec.cpp
+ * @brief BassMINT SysEx encode → decode round trips, versions 1 and 2
+ */
+
+#include "core/NoteMapping.h"
+#include "core/SysExDecoder.h"
+#include "core/SysExEncoder.h"
+#include "TestSupport.h"
+#include <vector>
+
+using namespace BassMINT;
+
+static const StringId STRINGS[NUM_STRINGS] = {StringId::E, StringId::A, StringId::D, StringId::G};
+
+static bool decodeBytes(const std::vector<uint8_t>& bytes, SysExDecoder::Frame& frame) {
+    return SysExDecoder::decode(bytes.data(), bytes.size(), frame);
+}
+
+static std::vector<uint8_t> bundleBytes(const SysExEncoder::FretSysExPayload* updates, size_t count) {
+    SysExEncoder::BundleMessage message;
+    size_t length = SysExEncoder::encodeBundle(updates, count, message);
+    return std::vector<uint8_t>(message.begin(), message.begin() + length);
+}
+
+static void testVersion1RoundTrip() {
+    for (StringId string : STRINGS) {
+        for (int fret : {0, 1, 12, NoteMapping::MAX_FRET}) {
+            for (uint8_t velocity : {1, 64, 127}) {
+                uint8_t note = NoteMapping::fretToMidiNote(string, fret);
+                auto message = SysExEncoder::encode(SysExEncoder::FretSysExPayload(string, fret, note, velocity));
+
+                SysExDecoder::Frame frame;
+                CHECK(SysExDecoder::decode(message.data(), message.size(), frame));
+                CHECK(frame.version == SysExEncoder::PROTOCOL_VERSION);
+                CHECK(frame.count == 1);
+                CHECK(frame.updates[0].string == string);
+                CHECK(frame.updates[0].fret == fret);
+                CHECK(frame.updates[0].midiNote == note);
+                CHECK(frame.updates[0].velocity == velocity);
+            }
+        }
+    }
+}
+
+static void testVersion2RoundTrip() {
+    // Every non-empty string mask, frets and velocities differing per string
+    for (uint8_t mask = 1; mask < (1u << NUM_STRINGS); ++mask) {
+        std::vector<SysExEncoder::FretSysExPayload> updates;
+        for (uint8_t i = 0; i < NUM_STRINGS; ++i) {
+            if (mask & (1u << i)) {
+                int fret = (mask * 5 + i * 7) % (NoteMapping::MAX_FRET + 1);
+                updates.emplace_back(STRINGS[i], fret, NoteMapping::fretToMidiNote(STRINGS[i], fret),
+                                     static_cast<uint8_t>(30 + 20 * i));
+            }
+        }
+
+        auto bytes = bundleBytes(updates.data(), updates.size());
+        CHECK(bytes.size() == SysExEncoder::HEADER_SIZE + 2 + 2 * updates.size());
+        CHECK(bytes[4] == SysExEncoder::PROTOCOL_VERSION_BUNDLE);
+        CHECK(bytes[5] == mask);
+
+        SysExDecoder::Frame frame;
+        CHECK(decodeBytes(bytes, frame));
+        CHECK(frame.version == SysExEncoder::PROTOCOL_VERSION_BUNDLE);
+        CHECK(frame.count == updates.size());
+        for (size_t k = 0; k < updates.size() && k < frame.count; ++k) {
+            CHECK(frame.updates[k].string == updates[k].string);
+            CHECK(frame.updates[k].fret == updates[k].fret);
+            CHECK(frame.updates[k].midiNote == updates[k].midiNote);
+            CHECK(frame.updates[k].velocity == updates[k].velocity);
+        }
+    }
+
+    // Out of order, a string twice: the later update wins, strings ascend
+    SysExEncoder::FretSysExPayload updates[] = {
+        SysExEncoder::FretSysExPayload(StringId::G, 3, 46, 100),
+        SysExEncoder::FretSysExPayload(StringId::A, 7, 40, 90),
+        SysExEncoder::FretSysExPayload(StringId::G, 5, 48, 80)
+    };
+    SysExDecoder::Frame frame;
+    CHECK(decodeBytes(bundleBytes(updates, 3), frame));
+    CHECK(frame.count == 2);
+    CHECK(frame.updates[0].string == StringId::A && frame.updates[0].fret == 7);
+    CHECK(frame.updates[1].string == StringId::G && frame.updates[1].fret == 5);
+    CHECK(frame.updates[1].velocity == 80);
+
+    // Nothing to encode
+    CHECK(bundleBytes(updates, 0).empty());
+    CHECK(bundleBytes(nullptr, 3).empty());
+}
+
+static void testMalformedLength() {
+    SysExDecoder::Frame frame;
+    auto single = SysExEncoder::encode(SysExEncoder::FretSysExPayload(StringId::D, 5, 43, 100));
+    std::vector<uint8_t> v1(single.begin(), single.end());
+
+    SysExEncoder::FretSysExPayload updates[] = {
+        SysExEncoder::FretSysExPayload(StringId::E, 1, 29, 100),
+        SysExEncoder::FretSysExPayload(StringId::D, 2, 40, 100)
+    };
+    auto v2 = bundleBytes(updates, 2);
+    CHECK(v2.size() == 11);
+
+    for (const auto* valid : {&v1, &v2}) {
+        // Every truncation, closed with F7 again so only the length is wrong
+        for (size_t length = 0; length < valid->size(); ++length) {
+            std::vector<uint8_t> shorter(valid->begin(), valid->begin() + length);
+            CHECK(!decodeBytes(shorter, frame));
+            if (length >= 2) {
+                shorter.back() = SysExEncoder::SYSEX_END;
+                CHECK(!decodeBytes(shorter, frame));
+                CHECK(frame.count == 0);
+            }
+        }
+
+        // One data byte too many
+        std::vector<uint8_t> longer(*valid);
+        longer.insert(longer.end() - 1, 0x01);
+        CHECK(!decodeBytes(longer, frame));
+
+        // Unterminated
+        std::vector<uint8_t> open(*valid);
+        open.back() = 0x01;
+        CHECK(!decodeBytes(open, frame));
+    }
+
+    CHECK(!SysExDecoder::decode(nullptr, 10, frame));
+}
+
+static void testMalformedMask() {
+    SysExDecoder::Frame frame;
+    SysExEncoder::FretSysExPayload all[NUM_STRINGS] = {
+        SysExEncoder::FretSysExPayload(StringId::E, 3, 31, 100),
+        SysExEncoder::FretSysExPayload(StringId::A, 3, 36, 100),
+        SysExEncoder::FretSysExPayload(StringId::D, 3, 41, 100),
+        SysExEncoder::FretSysExPayload(StringId::G, 3, 46, 100)
+    };
+    auto valid = bundleBytes(all, NUM_STRINGS);
+    CHECK(valid.size() == SysExEncoder::BUNDLE_MAX_SIZE);
+
+    // Every 7-bit mask against a four-string body: only 0x0F fits; no
+    // string, or strings past G, are refused whatever the length
+    for (uint8_t mask = 0; mask < 0x80; ++mask) {
+        std::vector<uint8_t> bytes(valid);
+        bytes[5] = mask;
+        CHECK(decodeBytes(bytes, frame) == (mask == 0x0F));
+    }
+
+    // Strings past G with a length that matches their bit count
+    std::vector<uint8_t> fifth(valid);
+    fifth[5] = 0x1F;
+    fifth.insert(fifth.end() - 1, {3, 100});
+    CHECK(!decodeBytes(fifth, frame));
+
+    // Mask of one string on a two-string body, and the other way round
+    auto one = bundleBytes(all, 1);
+    std::vector<uint8_t> widened(one);
+    widened[5] = 0x03;
+    CHECK(!decodeBytes(widened, frame));
+    std::vector<uint8_t> narrowed(bundleBytes(all, 2));
+    narrowed[5] = 0x01;
+    CHECK(!decodeBytes(narrowed, frame));
+
+    // Fret past the last one
+    std::vector<uint8_t> highFret(valid);
+    highFret[6] = NoteMapping::MAX_FRET + 1;
+    CHECK(!decodeBytes(highFret, frame));
+    CHECK(frame.count == 0);
+}
+
+static void testMalformedHeader() {
+    SysExDecoder::Frame frame;
+    auto single = SysExEncoder::encode(SysExEncoder::FretSysExPayload(StringId::A, 2, 35, 100));
+    std::vector<uint8_t> v1(single.begin(), single.end());
+    CHECK(decodeBytes(v1, frame));
+
+    // Each header byte wrong, an unknown version, string index past G, an
+    // 8-bit data byte
+    for (size_t i = 0; i < SysExEncoder::HEADER_SIZE; ++i) {
+        std::vector<uint8_t> bytes(v1);
+        bytes[i] ^= 0x01;
+        CHECK(!decodeBytes(bytes, frame));
+    }
+    std::vector<uint8_t> version3(v1);
+    version3[4] = 0x03;
+    CHECK(!decodeBytes(version3, frame));
+    std::vector<uint8_t> fifthString(v1);
+    fifthString[5] = NUM_STRINGS;
+    CHECK(!decodeBytes(fifthString, frame));
+    std::vector<uint8_t> eightBit(v1);
+    eightBit[8] = 0x80 | 100;
+    CHECK(!decodeBytes(eightBit, frame));
+}
+
+int main() {
+    testVersion1RoundTrip();
+    testVersion2RoundTrip();
+    testMalformedLength();
+    testMalformedMask();
+    testMalformedHeader();
+    return Test::finish("SysExCodec");
+}
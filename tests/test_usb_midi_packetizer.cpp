@@ -0,0 +1,181 @@
+/**
+ * @file test_usb_midi_packetizer.cpp
+ * @brief UsbMidiPacketizer CINs, SysEx splitting and whole-or-nothing adds
+ */
+
+#include "hal/UsbMidiPacketizer.h"
+#include "core/SysExEncoder.h"
+#include "TestSupport.h"
+#include <vector>
+
+using namespace BassMINT;
+
+using Packetizer = UsbMidiPacketizer<16>;
+
+static const uint8_t* packetAt(const Packetizer& packets, size_t index) {
+    return packets.data() + index * Packetizer::PACKET_SIZE;
+}
+
+static bool packetIs(const Packetizer& packets, size_t index,
+                     uint8_t header, uint8_t b0, uint8_t b1, uint8_t b2) {
+    const uint8_t* packet = packetAt(packets, index);
+    return packet[0] == header && packet[1] == b0 && packet[2] == b1 && packet[3] == b2;
+}
+
+static void testChannelMessages() {
+    Packetizer packets;
+
+    CHECK(packets.addNoteOff(2, 40, 64));
+    CHECK(packets.addNoteOn(2, 40, 100));
+    CHECK(packets.addChannelMessage(0xA3, 41, 30));  // Poly pressure
+    CHECK(packets.addControlChange(0, 101, 0));
+    CHECK(packets.addChannelMessage(0xC4, 33, 99));  // Program Change: data2 dropped
+    CHECK(packets.addChannelMessage(0xD5, 90, 99));  // Channel Pressure: data2 dropped
+    CHECK(packets.addPitchBend(1, 0x2001));
+
+    CHECK(packets.getPacketCount() == 7);
+    CHECK(packets.getByteCount() == 28);
+
+    // CIN = status high nibble, no running status
+    CHECK(packetIs(packets, 0, 0x08, 0x82, 40, 64));
+    CHECK(packetIs(packets, 1, 0x09, 0x92, 40, 100));
+    CHECK(packetIs(packets, 2, 0x0A, 0xA3, 41, 30));
+    CHECK(packetIs(packets, 3, 0x0B, 0xB0, 101, 0));
+    CHECK(packetIs(packets, 4, 0x0C, 0xC4, 33, 0));
+    CHECK(packetIs(packets, 5, 0x0D, 0xD5, 90, 0));
+    CHECK(packetIs(packets, 6, 0x0E, 0xE1, 0x01, 0x40));
+
+    // Not channel messages
+    CHECK(!packets.addChannelMessage(0x40, 1, 2));
+    CHECK(!packets.addChannelMessage(0xF0, 1, 2));
+    CHECK(!packets.addChannelMessage(0xF8, 0, 0));
+    CHECK(packets.getPacketCount() == 7);
+
+    // Cable number in the high nibble, data bytes masked to 7 bits
+    UsbMidiPacketizer<4> cable3(3);
+    CHECK(cable3.addNoteOn(0, 0xC0, 0xFF));
+    const uint8_t* packet = cable3.data();
+    CHECK(packet[0] == 0x39);
+    CHECK(packet[2] == 0x40 && packet[3] == 0x7F);
+}
+
+/**
+ * @brief Check the SysEx packets from index first reproduce message
+ */
+static void checkSysEx(const Packetizer& packets, size_t first, const uint8_t* message,
+                       size_t length) {
+    size_t count = Packetizer::packetsForSysEx(length);
+    std::vector<uint8_t> bytes;
+
+    for (size_t i = 0; i < count; ++i) {
+        const uint8_t* packet = packetAt(packets, first + i);
+        uint8_t cin = packet[0] & 0x0F;
+        size_t carried = 3;
+
+        if (i + 1 < count) {
+            CHECK(cin == Packetizer::CIN_SYSEX_START);
+        } else {
+            // Last packet: 0x5/0x6/0x7 for 1/2/3 bytes, unused bytes zero
+            carried = length - 3 * i;
+            CHECK(cin == Packetizer::CIN_SYSEX_END_1 + carried - 1);
+            for (size_t k = carried; k < 3; ++k) {
+                CHECK(packet[1 + k] == 0);
+            }
+        }
+        bytes.insert(bytes.end(), packet + 1, packet + 1 + carried);
+    }
+
+    CHECK(bytes == std::vector<uint8_t>(message, message + length));
+}
+
+static void testSysExSplit() {
+    // The real frames: v1 fret message (10 bytes, 10 % 3 = 1) and a
+    // four-string v2 bundle (15 bytes, 15 % 3 = 0)
+    auto single = SysExEncoder::encode(SysExEncoder::FretSysExPayload(StringId::A, 5, 38, 100));
+    SysExEncoder::FretSysExPayload updates[NUM_STRINGS] = {
+        SysExEncoder::FretSysExPayload(StringId::E, 3, 31, 100),
+        SysExEncoder::FretSysExPayload(StringId::A, 3, 36, 100),
+        SysExEncoder::FretSysExPayload(StringId::D, 3, 41, 100),
+        SysExEncoder::FretSysExPayload(StringId::G, 3, 46, 100)
+    };
+    SysExEncoder::BundleMessage bundle;
+    size_t bundleLength = SysExEncoder::encodeBundle(updates, NUM_STRINGS, bundle);
+    CHECK(single.size() == 10);
+    CHECK(bundleLength == 15);
+
+    Packetizer packets;
+    CHECK(packets.addSysEx(single.data(), single.size()));
+    CHECK(packets.getPacketCount() == 4);
+    checkSysEx(packets, 0, single.data(), single.size());
+    CHECK((packetAt(packets, 3)[0] & 0x0F) == Packetizer::CIN_SYSEX_END_1);
+
+    CHECK(packets.addSysEx(bundle.data(), bundleLength));
+    CHECK(packets.getPacketCount() == 9);
+    checkSysEx(packets, 4, bundle.data(), bundleLength);
+    CHECK((packetAt(packets, 8)[0] & 0x0F) == Packetizer::CIN_SYSEX_END_3);
+
+    // Bundle of two strings (11 bytes, 11 % 3 = 2)
+    size_t pairLength = SysExEncoder::encodeBundle(updates, 2, bundle);
+    CHECK(pairLength == 11);
+    packets.clear();
+    CHECK(packets.addSysEx(bundle.data(), pairLength));
+    checkSysEx(packets, 0, bundle.data(), pairLength);
+    CHECK((packetAt(packets, 3)[0] & 0x0F) == Packetizer::CIN_SYSEX_END_2);
+
+    // Shortest forms end at once
+    const uint8_t empty[2] = {0xF0, 0xF7};
+    const uint8_t one[3] = {0xF0, 0x7D, 0xF7};
+    packets.clear();
+    CHECK(packets.addSysEx(empty, 2));
+    CHECK(packets.addSysEx(one, 3));
+    CHECK(packetIs(packets, 0, 0x06, 0xF0, 0xF7, 0));
+    CHECK(packetIs(packets, 1, 0x07, 0xF0, 0x7D, 0xF7));
+
+    // Malformed frames are refused
+    const uint8_t unterminated[3] = {0xF0, 0x7D, 0x01};
+    const uint8_t noStart[3] = {0x7D, 0x01, 0xF7};
+    CHECK(!packets.addSysEx(unterminated, 3));
+    CHECK(!packets.addSysEx(noStart, 3));
+    CHECK(!packets.addSysEx(nullptr, 3));
+    CHECK(!packets.addSysEx(empty, 1));
+    CHECK(packets.getPacketCount() == 2);
+}
+
+static void testFullBufferRejectsWholeMessage() {
+    auto single = SysExEncoder::encode(SysExEncoder::FretSysExPayload(StringId::D, 7, 45, 90));
+
+    // 16 packets: three 4-packet SysEx, then 3 notes leave one free
+    Packetizer packets;
+    for (int i = 0; i < 3; ++i) {
+        CHECK(packets.addSysEx(single.data(), single.size()));
+    }
+    for (uint8_t i = 0; i < 3; ++i) {
+        CHECK(packets.addNoteOn(0, static_cast<uint8_t>(40 + i), 100));
+    }
+    CHECK(packets.getFreePackets() == 1);
+
+    // A 4-packet SysEx does not fit: nothing of it is written
+    std::vector<uint8_t> before(packets.data(), packets.data() + packets.getByteCount());
+    CHECK(!packets.addSysEx(single.data(), single.size()));
+    CHECK(packets.getPacketCount() == 15);
+    CHECK(std::vector<uint8_t>(packets.data(), packets.data() + packets.getByteCount()) == before);
+
+    // The last packet still takes a channel message, then nothing does
+    CHECK(packets.addNoteOff(0, 40, 64));
+    CHECK(packets.getFreePackets() == 0);
+    CHECK(!packets.addNoteOn(0, 41, 100));
+    const uint8_t empty[2] = {0xF0, 0xF7};
+    CHECK(!packets.addSysEx(empty, 2));
+    CHECK(packets.getPacketCount() == 16);
+
+    packets.clear();
+    CHECK(packets.isEmpty());
+    CHECK(packets.getFreePackets() == 16);
+}
+
+int main() {
+    testChannelMessages();
+    testSysExSplit();
+    testFullBufferRejectsWholeMessage();
+    return Test::finish("UsbMidiPacketizer");
+}
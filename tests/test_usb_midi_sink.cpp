@@ -0,0 +1,176 @@
+/**
+ * @file test_usb_midi_sink.cpp
+ * @brief MPE configuration on every sink, repeated when a USB host connects
+ *
+ * NoteBus with both outputs subscribed, as App sets it up with
+ * BASSMINT_USB_MIDI: MidiScheduler on the fake UART, UsbMidiSink on the
+ * fake TinyUSB MIDI driver.
+ */
+
+#include "app/MidiScheduler.h"
+#include "app/NoteEventBus.h"
+#include "app/UsbMidiSink.h"
+#include "hal/MidiDinOut.h"
+#include "hal/UsbMidiOut.h"
+#include "hardware/uart.h"
+#include "tusb.h"
+#include "TestSupport.h"
+#include <array>
+#include <vector>
+
+using namespace BassMINT;
+
+using Packet = std::array<uint8_t, 4>;
+
+// RPN 6 select, 4 member channels, RPN null, on master channel 1
+static const uint8_t MPE_CONFIGURATION[5][3] = {
+    {0xB0, 101, 0}, {0xB0, 100, 6}, {0xB0, 6, NUM_STRINGS}, {0xB0, 101, 127}, {0xB0, 100, 127}
+};
+
+static std::vector<Packet> mpePackets() {
+    std::vector<Packet> packets;
+    for (const auto& cc : MPE_CONFIGURATION) {
+        packets.push_back({0x0B, cc[0], cc[1], cc[2]});
+    }
+    return packets;
+}
+
+struct Outputs {
+    MidiDinOut midi;
+    MidiScheduler scheduler{midi};
+    UsbMidiOut usb;
+    UsbMidiSink usbSink{usb};
+    NoteBus bus;
+
+    Outputs() {
+        midi.init();
+        UsbMidiOut::initDevice();
+        bus.subscribe(scheduler);
+        bus.subscribe(usbSink);
+    }
+
+    /**
+     * @brief One main loop pass, in App::tick() order
+     */
+    void tick() {
+        if (usb.task()) {
+            usbSink.onConnected();
+        }
+        bus.dispatch();
+        scheduler.service();
+    }
+
+    /**
+     * @brief Let the host read until the class FIFO is empty
+     */
+    void deliver() {
+        while (!g_fakeUsbMidi.inFlight.empty() || !g_fakeUsbMidi.fifo.empty()) {
+            tud_task();
+        }
+    }
+};
+
+static void testConfigurationOnEverySink() {
+    Outputs outputs;
+    g_fakeUsbMidi.mounted = true;
+    outputs.tick(); // Mount edge, nothing announced yet
+    CHECK(g_fakeUsbMidi.sent.empty());
+
+    // App::sendMpeConfiguration(), then the first note
+    outputs.bus.publish(NoteEvent::mpeConfiguration(MPE_MASTER_CHANNEL, NUM_STRINGS));
+    outputs.bus.publish(NoteEvent::noteOn(StringId::A, 2, 45, 100, 0));
+    outputs.tick();
+
+    // DIN: the five Control Changes, then the note
+    outputs.midi.flush();
+    std::vector<uint8_t> expected;
+    for (const auto& cc : MPE_CONFIGURATION) {
+        expected.insert(expected.end(), cc, cc + 3);
+    }
+    const uint8_t noteOn[3] = {0x92, 45, 100};
+    expected.insert(expected.end(), noteOn, noteOn + 3);
+    CHECK(g_fakeUart.wire == expected);
+
+    // USB: the same; the first packet starts a transfer, the rest of the
+    // pass follows in the next one
+    outputs.deliver();
+    auto packets = mpePackets();
+    packets.push_back({0x09, 0x92, 45, 100});
+    CHECK(g_fakeUsbMidi.sent == packets);
+    CHECK(g_fakeUsbMidi.transfers == std::vector<size_t>({1, 5}));
+    CHECK(outputs.usb.getDroppedPackets() == 0);
+}
+
+static void testRepeatedOnConnect() {
+    Outputs outputs;
+
+    // Announced at init with no host: dropped on USB, sent on DIN
+    outputs.bus.publish(NoteEvent::mpeConfiguration(MPE_MASTER_CHANNEL, NUM_STRINGS));
+    outputs.tick();
+    CHECK(g_fakeUsbMidi.sent.empty());
+    CHECK(outputs.usb.getDroppedPackets() == 5);
+    outputs.midi.flush();
+    CHECK(g_fakeUart.wire.size() == 15);
+
+    outputs.tick();
+    CHECK(g_fakeUsbMidi.sent.empty());
+
+    // Host opens the interface while a note is played: configuration first
+    g_fakeUsbMidi.mounted = true;
+    outputs.bus.publish(NoteEvent::noteOn(StringId::E, 1, 40, 100, 0));
+    outputs.tick();
+    outputs.deliver();
+    auto packets = mpePackets();
+    packets.push_back({0x09, 0x91, 40, 100});
+    CHECK(g_fakeUsbMidi.sent == packets);
+    CHECK(g_fakeUsbMidi.transfers == std::vector<size_t>({1, 5}));
+
+    outputs.midi.flush();
+    size_t wireBytes = g_fakeUart.wire.size();
+    CHECK(wireBytes == 15 + 3);
+
+    // Only on the edge
+    outputs.tick();
+    outputs.tick();
+    CHECK(g_fakeUsbMidi.sent.size() == packets.size());
+
+    // Unplugged and plugged back in: announced again
+    g_fakeUsbMidi.mounted = false;
+    outputs.tick();
+    g_fakeUsbMidi.mounted = true;
+    outputs.tick();
+    outputs.deliver();
+    CHECK(g_fakeUsbMidi.sent.size() == packets.size() + 5);
+    CHECK(std::vector<Packet>(g_fakeUsbMidi.sent.end() - 5, g_fakeUsbMidi.sent.end()) == mpePackets());
+
+    // DIN saw it once: nothing new on the wire
+    outputs.midi.flush();
+    CHECK(g_fakeUart.wire.size() == wireBytes);
+}
+
+static void testNoConfigurationNothingRepeated() {
+    // SingleChannel mode announces nothing, so a connect sends nothing
+    Outputs outputs;
+    g_fakeUsbMidi.mounted = true;
+    outputs.tick();
+    outputs.tick();
+    CHECK(g_fakeUsbMidi.sent.empty());
+    CHECK(outputs.usb.getTransfers() == 0);
+}
+
+static void testBootService() {
+    // An open serial port ends the boot wait at once: printf() services
+    // the stack from then on
+    UsbMidiOut::initDevice();
+    g_fakeUsbMidi.serialOpen = true;
+    UsbMidiOut::serviceFor(500);
+    CHECK(g_fakeUsbMidi.tasks == 0);
+}
+
+int main() {
+    testConfigurationOnEverySink();
+    testRepeatedOnConnect();
+    testNoConfigurationNothingRepeated();
+    testBootService();
+    return Test::finish("UsbMidiSink");
+}